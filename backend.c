@@ -0,0 +1,34 @@
+#include <string.h>
+
+#include "backend.h"
+
+/*
+ * The table of graph.h backends.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+const graph_backend *const graph_backends[] = {
+	&graph_backend_list,
+	&graph_backend_edges,
+	&graph_backend_csr,
+	&graph_backend_matrix,
+	NULL,
+};
+
+/**
+ * graph_backend_find() - Look up a backend by name.
+ * @name: Name of the backend, e.g. "list".
+ *
+ * Returns: The backend, or NULL if there is none with that name.
+ */
+const graph_backend *graph_backend_find(const char *name)
+{
+	for (int k = 0; graph_backends[k] != NULL; k++) {
+		if (!strcmp(graph_backends[k]->name, name)) {
+			return graph_backends[k];
+		}
+	}
+	return NULL;
+}
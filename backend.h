@@ -0,0 +1,66 @@
+#ifndef __BACKEND_H
+#define __BACKEND_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * Run time selection between the implementations of graph.h.
+ *
+ * Each implementation is compiled a second time by a small wrapper
+ * (backend_list.c, ...) that renames its functions through
+ * backend_rename.h and fills in a graph_backend with them, so all of
+ * them can be linked into one program next to each other and next to
+ * the plain graph4.c. Graphs and nodes are only valid with the backend
+ * that made them.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct graph_backend {
+	const char *name;
+	const char *desc;
+
+	// graph.h
+	bool (*nodes_are_equal)(const node *n1, const node *n2);
+	graph *(*empty)(int max_nodes);
+	bool (*is_empty)(const graph *g);
+	bool (*has_edges)(const graph *g);
+	graph *(*insert_node)(graph *g, const char *s);
+	node *(*find_node)(const graph *g, const char *s);
+	bool (*node_is_seen)(const graph *g, const node *n);
+	graph *(*node_set_seen)(graph *g, node *n, bool seen);
+	graph *(*reset_seen)(graph *g);
+	graph *(*insert_edge)(graph *g, node *n1, node *n2);
+	graph *(*delete_node)(graph *g, node *n);
+	graph *(*delete_edge)(graph *g, node *n1, node *n2);
+	node *(*choose_node)(const graph *g);
+	dlist *(*neighbours)(const graph *g, const node *n);
+	void (*kill)(graph *g);
+	void (*print)(const graph *g);
+
+	// graph_ext.h
+	int (*nodecount)(const graph *g);
+	int (*edgecount)(const graph *g);
+	int (*id_bound)(const graph *g);
+	int (*node_id)(const node *n);
+	const char *(*node_name)(const node *n);
+	dlist *(*nodes)(const graph *g);
+	node *(*try_find_node)(const graph *g, const char *s);
+	int (*find_nodes)(const graph *g, const char **names, int count, node **out);
+	int (*edges)(const graph *g, int *src, int *dest);
+	node *const *(*neighbours_span)(const graph *g, const node *n, int *count);
+} graph_backend;
+
+extern const graph_backend graph_backend_list;
+extern const graph_backend graph_backend_edges;
+extern const graph_backend graph_backend_csr;
+extern const graph_backend graph_backend_matrix;
+
+extern const graph_backend *const graph_backends[];
+
+const graph_backend *graph_backend_find(const char *name);
+
+#endif
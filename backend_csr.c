@@ -0,0 +1,15 @@
+/*
+ * The graph_csr.c implementation of graph.h as the "csr" backend.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define BACKEND_PREFIX backend_csr
+#include "backend_rename.h"
+#include "backend.h"
+
+#include "graph_csr.c"
+
+GRAPH_BACKEND(graph_backend_csr, "csr",
+	"Compressed sparse rows with a log of pending inserts");
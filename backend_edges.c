@@ -0,0 +1,15 @@
+/*
+ * The graph2.c implementation of graph.h as the "edges" backend.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define BACKEND_PREFIX backend_edges
+#include "backend_rename.h"
+#include "backend.h"
+
+#include "graph2.c"
+
+GRAPH_BACKEND(graph_backend_edges, "edges",
+	"Sorted edge array with an index built on demand");
@@ -0,0 +1,15 @@
+/*
+ * The graph4.c implementation of graph.h as the "list" backend.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define BACKEND_PREFIX backend_list
+#include "backend_rename.h"
+#include "backend.h"
+
+#include "graph4.c"
+
+GRAPH_BACKEND(graph_backend_list, "list",
+	"Adjacency lists, one dlist of neighbours per node");
@@ -0,0 +1,15 @@
+/*
+ * The graph_matrix.c implementation of graph.h as the "matrix" backend.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define BACKEND_PREFIX backend_matrix
+#include "backend_rename.h"
+#include "backend.h"
+
+#include "graph_matrix.c"
+
+GRAPH_BACKEND(graph_backend_matrix, "matrix",
+	"Bit-packed adjacency matrix, for small dense graphs");
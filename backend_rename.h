@@ -0,0 +1,74 @@
+#ifndef __BACKEND_RENAME_H
+#define __BACKEND_RENAME_H
+
+/*
+ * Renames the functions of graph.h and graph_ext.h to
+ * <BACKEND_PREFIX>_<name>. Define BACKEND_PREFIX and include this
+ * before the implementation, then use GRAPH_BACKEND() after it to
+ * define the backend struct.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#ifndef BACKEND_PREFIX
+#error "BACKEND_PREFIX must be defined before including backend_rename.h"
+#endif
+
+#define BACKEND_PASTE2(p, n) p ## _ ## n
+#define BACKEND_PASTE(p, n) BACKEND_PASTE2(p, n)
+#define BACKEND_NAME(n) BACKEND_PASTE(BACKEND_PREFIX, n)
+
+#define nodes_are_equal BACKEND_NAME(nodes_are_equal)
+#define graph_empty BACKEND_NAME(graph_empty)
+#define graph_is_empty BACKEND_NAME(graph_is_empty)
+#define graph_has_edges BACKEND_NAME(graph_has_edges)
+#define graph_insert_node BACKEND_NAME(graph_insert_node)
+#define graph_find_node BACKEND_NAME(graph_find_node)
+#define graph_node_is_seen BACKEND_NAME(graph_node_is_seen)
+#define graph_node_set_seen BACKEND_NAME(graph_node_set_seen)
+#define graph_reset_seen BACKEND_NAME(graph_reset_seen)
+#define graph_insert_edge BACKEND_NAME(graph_insert_edge)
+#define graph_delete_node BACKEND_NAME(graph_delete_node)
+#define graph_delete_edge BACKEND_NAME(graph_delete_edge)
+#define graph_choose_node BACKEND_NAME(graph_choose_node)
+#define graph_neighbours BACKEND_NAME(graph_neighbours)
+#define graph_kill BACKEND_NAME(graph_kill)
+#define graph_print BACKEND_NAME(graph_print)
+
+#define graph_nodecount BACKEND_NAME(graph_nodecount)
+#define graph_edgecount BACKEND_NAME(graph_edgecount)
+#define graph_id_bound BACKEND_NAME(graph_id_bound)
+#define graph_node_id BACKEND_NAME(graph_node_id)
+#define graph_node_name BACKEND_NAME(graph_node_name)
+#define graph_nodes BACKEND_NAME(graph_nodes)
+#define graph_try_find_node BACKEND_NAME(graph_try_find_node)
+#define graph_find_nodes BACKEND_NAME(graph_find_nodes)
+#define graph_edges BACKEND_NAME(graph_edges)
+#define graph_neighbours_span BACKEND_NAME(graph_neighbours_span)
+
+// ingest.h, graph4.c only.
+#define graph_ingest_begin BACKEND_NAME(graph_ingest_begin)
+#define graph_ingest_node BACKEND_NAME(graph_ingest_node)
+#define graph_ingest_edge BACKEND_NAME(graph_ingest_edge)
+#define graph_ingest_end BACKEND_NAME(graph_ingest_end)
+
+// batch.h, graph4.c only.
+#define graph_apply_ops BACKEND_NAME(graph_apply_ops)
+#define graph_version BACKEND_NAME(graph_version)
+
+/* Define the backend struct var from the renamed functions. */
+#define GRAPH_BACKEND(var, name, desc) \
+	const graph_backend var = { \
+		name, desc, \
+		nodes_are_equal, graph_empty, graph_is_empty, graph_has_edges, \
+		graph_insert_node, graph_find_node, graph_node_is_seen, \
+		graph_node_set_seen, graph_reset_seen, graph_insert_edge, \
+		graph_delete_node, graph_delete_edge, graph_choose_node, \
+		graph_neighbours, graph_kill, graph_print, \
+		graph_nodecount, graph_edgecount, graph_id_bound, graph_node_id, \
+		graph_node_name, graph_nodes, graph_try_find_node, \
+		graph_find_nodes, graph_edges, graph_neighbours_span, \
+	}
+
+#endif
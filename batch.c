@@ -0,0 +1,207 @@
+#include <stdlib.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "batch.h"
+
+/*
+ * Implementation of the backend independent part of batch.h.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static void add_op(graph_batch *b, node *n1, node *n2, int kind)
+{
+	if (b->len == b->cap) {
+		b->cap = b->cap ? 2 * b->cap : 64;
+		b->ops = realloc(b->ops, b->cap * sizeof(graph_op));
+	}
+	graph_op *op = &b->ops[b->len];
+	op->src = n1;
+	op->dest = n2;
+	op->srcid = graph_node_id(n1);
+	op->destid = graph_node_id(n2);
+	op->kind = kind;
+	op->seq = b->len++;
+}
+
+static int by_edge_seq(const void *a, const void *b)
+{
+	const graph_op *x = a;
+	const graph_op *y = b;
+	if (x->srcid != y->srcid) {
+		return x->srcid < y->srcid ? -1 : 1;
+	}
+	if (x->destid != y->destid) {
+		return x->destid < y->destid ? -1 : 1;
+	}
+	return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+static int by_id(const void *a, const void *b)
+{
+	int x = graph_node_id(*(node *const *)a);
+	int y = graph_node_id(*(node *const *)b);
+	return (x > y) - (x < y);
+}
+
+/* Return true if the node with the given id is in the sorted dead list. */
+static bool is_dead(const graph_batch *b, int id)
+{
+	int lo = 0;
+	int hi = b->deadlen;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		int x = graph_node_id(b->dead[mid]);
+		if (x == id) {
+			return true;
+		}
+		if (x < id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return false;
+}
+
+/**
+ * graph_batch_empty() - Create an empty batch.
+ *
+ * Returns: A pointer to the new batch.
+ */
+graph_batch *graph_batch_empty(void)
+{
+	return calloc(1, sizeof(graph_batch));
+}
+
+/**
+ * graph_batch_insert_edge() - Add an edge insert to the batch.
+ * @b: Batch to add to.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: Nothing.
+ */
+void graph_batch_insert_edge(graph_batch *b, node *n1, node *n2)
+{
+	add_op(b, n1, n2, GRAPH_OP_INSERT);
+}
+
+/**
+ * graph_batch_delete_edge() - Add an edge delete to the batch.
+ * @b: Batch to add to.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Deleting an edge that is not in the graph does nothing.
+ *
+ * Returns: Nothing.
+ */
+void graph_batch_delete_edge(graph_batch *b, node *n1, node *n2)
+{
+	add_op(b, n1, n2, GRAPH_OP_DELETE);
+}
+
+/**
+ * graph_batch_delete_node() - Add a node delete to the batch.
+ * @b: Batch to add to.
+ * @n: Node to delete, with all edges from and to it.
+ *
+ * Returns: Nothing.
+ */
+void graph_batch_delete_node(graph_batch *b, node *n)
+{
+	if (b->deadlen == b->deadcap) {
+		b->deadcap = b->deadcap ? 2 * b->deadcap : 16;
+		b->dead = realloc(b->dead, b->deadcap * sizeof(node *));
+	}
+	b->dead[b->deadlen++] = n;
+}
+
+/**
+ * graph_batch_prepare() - Sort the batch and drop redundant operations.
+ * @b: Batch to prepare.
+ *
+ * Afterwards the dead nodes are sorted by id without duplicates, and
+ * the edge operations are sorted by source and destination id with at
+ * most one per edge and none on a dead node. Preparing a prepared batch
+ * changes nothing. Called by graph_batch_apply().
+ *
+ * Returns: The number of edge operations left.
+ */
+int graph_batch_prepare(graph_batch *b)
+{
+	if (b->deadlen > 1) {
+		qsort(b->dead, b->deadlen, sizeof(node *), by_id);
+	}
+	int k = 0;
+	for (int i = 0; i < b->deadlen; i++) {
+		if (k == 0 || b->dead[k - 1] != b->dead[i]) {
+			b->dead[k++] = b->dead[i];
+		}
+	}
+	b->deadlen = k;
+
+	if (b->len > 1) {
+		qsort(b->ops, b->len, sizeof(graph_op), by_edge_seq);
+	}
+	k = 0;
+	for (int i = 0; i < b->len; i++) {
+		graph_op *op = &b->ops[i];
+		bool last = i + 1 == b->len || op[1].srcid != op->srcid
+			|| op[1].destid != op->destid;
+		if (last && !is_dead(b, op->srcid) && !is_dead(b, op->destid)) {
+			b->ops[k] = *op;
+			b->ops[k].seq = k;
+			k++;
+		}
+	}
+	b->cancelled += b->len - k;
+	b->len = k;
+	return k;
+}
+
+/**
+ * graph_batch_apply() - Apply a batch of updates to the graph.
+ * @g: Graph to manipulate.
+ * @b: Batch to apply. It is prepared but not cleared.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_batch_apply(graph *g, graph_batch *b)
+{
+	graph_batch_prepare(b);
+	return graph_apply_ops(g, b->ops, b->len, b->dead, b->deadlen);
+}
+
+/**
+ * graph_batch_clear() - Remove all operations from a batch.
+ * @b: Batch to clear.
+ *
+ * The memory is kept for the next batch.
+ *
+ * Returns: Nothing.
+ */
+void graph_batch_clear(graph_batch *b)
+{
+	b->len = 0;
+	b->deadlen = 0;
+	b->cancelled = 0;
+}
+
+/**
+ * graph_batch_kill() - Destroy a batch.
+ * @b: Batch to destroy.
+ *
+ * Returns: Nothing.
+ */
+void graph_batch_kill(graph_batch *b)
+{
+	free(b->ops);
+	free(b->dead);
+	free(b);
+}
@@ -0,0 +1,67 @@
+#ifndef __BATCH_H
+#define __BATCH_H
+
+#include "graph.h"
+
+/*
+ * Batches of graph updates that are applied together.
+ *
+ * Edge inserts, edge deletes and node deletes are collected in a
+ * graph_batch. graph_batch_prepare() sorts the edge operations by source
+ * and destination node id and keeps only the last operation on every
+ * edge, since that alone decides whether the edge is there afterwards.
+ * Edge operations that touch a deleted node are dropped, because the node
+ * takes its edges with it.
+ *
+ * graph_batch_apply() then changes the graph as if the operations had
+ * been made one by one, with edge operations first and node deletes
+ * last, but walks every touched neighbour list only once and the whole
+ * graph only once for all node deletes together. graph_version() counts
+ * changes to the graph; a batch counts as one change, so anything
+ * derived from the graph is invalidated once per batch.
+ *
+ * graph_apply_ops(), which does the work of graph_batch_apply(), and
+ * graph_version() are implemented by graph4.c only. The rest is in
+ * batch.c.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define GRAPH_OP_INSERT 0	// Insert the edge src -> dest.
+#define GRAPH_OP_DELETE 1	// Delete the edge src -> dest.
+
+typedef struct graph_op {
+	node *src;
+	node *dest;
+	int srcid;
+	int destid;
+	int kind;
+	int seq;	// Position in the batch, to keep the last operation.
+} graph_op;
+
+typedef struct graph_batch {
+	graph_op *ops;
+	int len;
+	int cap;
+	node **dead;	// Nodes to delete.
+	int deadlen;
+	int deadcap;
+	int cancelled;	// Operations dropped by graph_batch_prepare().
+} graph_batch;
+
+graph_batch *graph_batch_empty(void);
+void graph_batch_insert_edge(graph_batch *b, node *n1, node *n2);
+void graph_batch_delete_edge(graph_batch *b, node *n1, node *n2);
+void graph_batch_delete_node(graph_batch *b, node *n);
+int graph_batch_prepare(graph_batch *b);
+void graph_batch_clear(graph_batch *b);
+void graph_batch_kill(graph_batch *b);
+
+graph *graph_batch_apply(graph *g, graph_batch *b);
+
+graph *graph_apply_ops(graph *g, const graph_op *ops, int len,
+	node *const *dead, int deadlen);
+long graph_version(const graph *g);
+
+#endif
@@ -0,0 +1,167 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "path.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench bench.c gen.c path.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c
+
+/*
+ * Benchmark suite for implementations of graph.h. Link it with any of
+ * graph3.c, graph4.c, ... to compare them.
+ *
+ * Usage: bench [-o file] [-l label] [-q queries] [size ...]
+ *
+ * For every generator (random, hub, grid) and every size (default 500
+ * and 2000 nodes) the graph is built from scratch and each operation is
+ * timed call by call: graph_insert_node, graph_insert_edge,
+ * graph_find_node on every name, find_path on random pairs and
+ * graph_kill. One CSV row per operation is written with the call count,
+ * total time, throughput and the p50/p90/p99/max latency.
+ *
+ * Some implementations print while they work, so write the results to a
+ * file with -o and send stdout elsewhere.
+ */
+
+#define NAMELEN 16
+
+/* Return the p:th percentile of the sorted samples. */
+static long long percentile(const long long *ns, int n, double p)
+{
+	int i = (int)(p * (n - 1) + 0.5);
+	return ns[i];
+}
+
+static int by_value(const void *a, const void *b)
+{
+	long long x = *(const long long *)a;
+	long long y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+/* Write one CSV row for n timed calls of an operation. */
+static void report(FILE *out, const char *label, const char *gen,
+	const edgelist *e, const char *op, long long *ns, int n)
+{
+	long long total = 0;
+	for (int i = 0; i < n; i++) {
+		total += ns[i];
+	}
+	qsort(ns, n, sizeof(long long), by_value);
+	fprintf(out, "%s,%s,%d,%d,%s,%d,%.3f,%.1f,%lld,%lld,%lld,%lld\n",
+		label, gen, e->nodecount, e->edgecount, op, n, total / 1e6,
+		total > 0 ? n / (total / 1e9) : 0.0,
+		percentile(ns, n, 0.5), percentile(ns, n, 0.9),
+		percentile(ns, n, 0.99), ns[n - 1]);
+	fflush(out);
+}
+
+static void run(FILE *out, const char *label, const char *gen,
+	const edgelist *e, int queries, unsigned long long seed)
+{
+	int n = e->nodecount;
+	int m = e->edgecount;
+	char (*names)[NAMELEN] = malloc(n * sizeof(*names));
+	node **nodes = malloc(n * sizeof(node *));
+	long long *ns = malloc(((n > m ? n : m) + queries + 1) * sizeof(long long));
+
+	for (int i = 0; i < n; i++) {
+		sprintf(names[i], "N%d", i);
+	}
+
+	graph *g = graph_empty(n);
+	for (int i = 0; i < n; i++) {
+		long long t0 = timer_now();
+		g = graph_insert_node(g, names[i]);
+		ns[i] = timer_now() - t0;
+	}
+	report(out, label, gen, e, "insert_node", ns, n);
+
+	for (int i = 0; i < n; i++) {
+		long long t0 = timer_now();
+		nodes[i] = graph_find_node(g, names[i]);
+		ns[i] = timer_now() - t0;
+	}
+	report(out, label, gen, e, "find_node", ns, n);
+
+	for (int i = 0; i < m; i++) {
+		node *n1 = nodes[e->src[i]];
+		node *n2 = nodes[e->dest[i]];
+		long long t0 = timer_now();
+		g = graph_insert_edge(g, n1, n2);
+		ns[i] = timer_now() - t0;
+	}
+	report(out, label, gen, e, "insert_edge", ns, m);
+
+	unsigned long long state = seed | 1;
+	for (int i = 0; i < queries; i++) {
+		node *src = nodes[gen_rand(&state) % n];
+		node *dest = nodes[gen_rand(&state) % n];
+		long long t0 = timer_now();
+		find_path(g, src, dest);
+		ns[i] = timer_now() - t0;
+	}
+	report(out, label, gen, e, "find_path", ns, queries);
+
+	long long t0 = timer_now();
+	graph_kill(g);
+	ns[0] = timer_now() - t0;
+	report(out, label, gen, e, "kill", ns, 1);
+
+	free(ns);
+	free(nodes);
+	free(names);
+}
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	const char *label = "graph";
+	const char *out_name = NULL;
+	int queries = 1000;
+	unsigned long long seed = 12345;
+	int sizes[32];
+	int nsizes = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+			out_name = argv[++i];
+		} else if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+			label = argv[++i];
+		} else if (!strcmp(argv[i], "-q") && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			queries = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench [-o file] [-l label] [-q queries] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 500;
+		sizes[nsizes++] = 2000;
+	}
+
+	FILE *out = stdout;
+	if (out_name != NULL && (out = fopen(out_name, "w")) == NULL) {
+		perror(out_name);
+		return -1;
+	}
+	fprintf(out, "backend,generator,nodes,edges,op,count,total_ms,ops_per_s,p50_ns,p90_ns,p99_ns,max_ns\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int k = 0; k < 3; k++) {
+			edgelist *e = gen_by_name(gens[k], sizes[s], seed + s);
+			run(out, label, gens[k], e, queries, seed + s);
+			edgelist_kill(e);
+		}
+	}
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,285 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "backend.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_backends bench_backends.c backend.c backend_list.c backend_edges.c backend_csr.c backend_matrix.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Runs the same workload against every graph.h backend in backend.c,
+ * checks that they agree and reports how long each phase took.
+ *
+ * Usage: bench_backends [-b backend ...] [-q queries] [size ...]
+ *
+ * For every generator (random, hub, grid) and every size (default 500
+ * and 2000 nodes) each backend builds the graph, looks up every name,
+ * answers the same random reachability queries with a BFS over
+ * graph_neighbours() and again over graph_neighbours_span(), deletes
+ * every tenth edge and answers the queries again. The answers and the
+ * final edge set of every backend are compared with those of the first
+ * one; the mismatches column counts differences. One CSV row per backend
+ * and graph is written. The exit status is 1 if any backend disagreed.
+ */
+
+#define NAMELEN 16
+
+/* Workload state shared by the backends of one graph. */
+struct workload {
+	const edgelist *e;
+	char (*names)[NAMELEN];
+	int *qsrc;
+	int *qdest;
+	int queries;
+	// Reference results, from the first backend.
+	bool have_ref;
+	bool *ref;
+	int refm;
+	int *refsrc;
+	int *refdest;
+};
+
+/*
+ * Is there a path from src to dest? Breadth first over the backend,
+ * walking neighbours with graph_neighbours() or, if span is set,
+ * graph_neighbours_span().
+ */
+static bool reach(const graph_backend *b, graph *g, node *src, node *dest,
+	node **queue, bool span)
+{
+	int head = 0;
+	int tail = 0;
+	b->reset_seen(g);
+	b->node_set_seen(g, src, true);
+	queue[tail++] = src;
+	while (head < tail) {
+		node *n = queue[head++];
+		if (b->nodes_are_equal(n, dest)) {
+			return true;
+		}
+		if (span) {
+			int count;
+			node *const *nb = b->neighbours_span(g, n, &count);
+			for (int k = 0; k < count; k++) {
+				if (!b->node_is_seen(g, nb[k])) {
+					b->node_set_seen(g, nb[k], true);
+					queue[tail++] = nb[k];
+				}
+			}
+			continue;
+		}
+		dlist *l = b->neighbours(g, n);
+		for (dlist_pos p = dlist_first(l); !dlist_is_end(l, p); p = dlist_next(l, p)) {
+			node *nb = dlist_inspect(l, p);
+			if (!b->node_is_seen(g, nb)) {
+				b->node_set_seen(g, nb, true);
+				queue[tail++] = nb;
+			}
+		}
+	}
+	return false;
+}
+
+static int by_edge(const void *a, const void *b)
+{
+	const long long x = *(const long long *)a;
+	const long long y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Return the number of edges in src/dest, translated from backend ids to
+ * generator node numbers through num and sorted, in key.
+ */
+static int edge_keys(const graph_backend *b, graph *g, const int *num,
+	long long *key)
+{
+	int m = b->edgecount(g);
+	int *src = malloc((m + 1) * sizeof(int));
+	int *dest = malloc((m + 1) * sizeof(int));
+	m = b->edges(g, src, dest);
+	for (int k = 0; k < m; k++) {
+		key[k] = (long long)num[src[k]] << 32 | num[dest[k]];
+	}
+	qsort(key, m, sizeof(long long), by_edge);
+	free(src);
+	free(dest);
+	return m;
+}
+
+static bool run(const graph_backend *b, const char *gen, struct workload *w)
+{
+	const edgelist *e = w->e;
+	int n = e->nodecount;
+	int m = e->edgecount;
+	node **nodes = malloc(n * sizeof(node *));
+	node **queue = malloc(n * sizeof(node *));
+	bool *answer = malloc(2 * w->queries * sizeof(bool));
+	int mismatches = 0;
+	double ms[6];
+
+	// Build.
+	long long t0 = timer_now();
+	graph *g = b->empty(n);
+	for (int i = 0; i < n; i++) {
+		// insert_node() puts the new node first, so choose_node() finds it.
+		g = b->insert_node(g, w->names[i]);
+		nodes[i] = b->choose_node(g);
+	}
+	for (int i = 0; i < m; i++) {
+		g = b->insert_edge(g, nodes[e->src[i]], nodes[e->dest[i]]);
+	}
+	ms[0] = (timer_now() - t0) / 1e6;
+
+	// Look up every name.
+	t0 = timer_now();
+	for (int i = 0; i < n; i++) {
+		nodes[i] = b->find_node(g, w->names[i]);
+	}
+	ms[1] = (timer_now() - t0) / 1e6;
+
+	// Queries, deletes, queries again.
+	t0 = timer_now();
+	for (int i = 0; i < w->queries; i++) {
+		answer[i] = reach(b, g, nodes[w->qsrc[i]], nodes[w->qdest[i]], queue,
+			false);
+	}
+	ms[2] = (timer_now() - t0) / 1e6;
+
+	t0 = timer_now();
+	for (int i = 0; i < w->queries; i++) {
+		mismatches += answer[i] != reach(b, g, nodes[w->qsrc[i]],
+			nodes[w->qdest[i]], queue, true);
+	}
+	ms[5] = (timer_now() - t0) / 1e6;
+
+	t0 = timer_now();
+	for (int i = 0; i < m; i += 10) {
+		g = b->delete_edge(g, nodes[e->src[i]], nodes[e->dest[i]]);
+	}
+	ms[3] = (timer_now() - t0) / 1e6;
+
+	t0 = timer_now();
+	for (int i = 0; i < w->queries; i++) {
+		answer[w->queries + i] = reach(b, g, nodes[w->qsrc[i]],
+			nodes[w->qdest[i]], queue, true);
+	}
+	ms[4] = (timer_now() - t0) / 1e6;
+
+	// Compare with the first backend.
+	int *num = malloc((b->id_bound(g) + 1) * sizeof(int));
+	for (int i = 0; i < n; i++) {
+		num[b->node_id(nodes[i])] = i;
+	}
+	long long *key = malloc((m + 1) * sizeof(long long));
+	int keys = edge_keys(b, g, num, key);
+	if (!w->have_ref) {
+		w->have_ref = true;
+		w->ref = answer;
+		answer = NULL;
+		w->refm = keys;
+		w->refsrc = malloc((keys + 1) * sizeof(int));
+		w->refdest = malloc((keys + 1) * sizeof(int));
+		for (int k = 0; k < keys; k++) {
+			w->refsrc[k] = key[k] >> 32;
+			w->refdest[k] = key[k] & 0xffffffff;
+		}
+	} else {
+		for (int i = 0; i < 2 * w->queries; i++) {
+			mismatches += answer[i] != w->ref[i];
+		}
+		if (keys != w->refm) {
+			mismatches += abs(keys - w->refm);
+		}
+		for (int k = 0; k < keys && k < w->refm; k++) {
+			mismatches += key[k] >> 32 != w->refsrc[k]
+				|| (key[k] & 0xffffffff) != w->refdest[k];
+		}
+	}
+
+	printf("%s,%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d\n", b->name, gen,
+		n, m, ms[0], ms[1], ms[2], ms[5], ms[3], ms[4], mismatches);
+	fflush(stdout);
+	b->kill(g);
+	free(key);
+	free(num);
+	free(answer);
+	free(queue);
+	free(nodes);
+	return mismatches == 0;
+}
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	const graph_backend *backends[16];
+	int nbackends = 0;
+	int queries = 1000;
+	unsigned long long seed = 12345;
+	int sizes[32];
+	int nsizes = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-b") && i + 1 < argc && nbackends < 16) {
+			backends[nbackends] = graph_backend_find(argv[++i]);
+			if (backends[nbackends] == NULL) {
+				fprintf(stderr, "Unknown backend %s\n", argv[i]);
+				return -1;
+			}
+			nbackends++;
+		} else if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			queries = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_backends [-b backend ...] [-q queries] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nbackends == 0) {
+		while (graph_backends[nbackends] != NULL) {
+			backends[nbackends] = graph_backends[nbackends];
+			nbackends++;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 500;
+		sizes[nsizes++] = 2000;
+	}
+
+	bool ok = true;
+	printf("backend,generator,nodes,edges,build_ms,lookup_ms,query_ms,query_span_ms,delete_ms,requery_ms,mismatches\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int k = 0; k < 3; k++) {
+			edgelist *e = gen_by_name(gens[k], sizes[s], seed + s);
+			struct workload w = { .e = e, .queries = queries };
+			unsigned long long state = (seed + s) | 1;
+
+			w.names = malloc(e->nodecount * sizeof(*w.names));
+			for (int i = 0; i < e->nodecount; i++) {
+				sprintf(w.names[i], "N%d", i);
+			}
+			w.qsrc = malloc(queries * sizeof(int));
+			w.qdest = malloc(queries * sizeof(int));
+			for (int i = 0; i < queries; i++) {
+				w.qsrc[i] = gen_rand(&state) % e->nodecount;
+				w.qdest[i] = gen_rand(&state) % e->nodecount;
+			}
+			for (int b = 0; b < nbackends; b++) {
+				ok = run(backends[b], gens[k], &w) && ok;
+			}
+			free(w.ref);
+			free(w.refsrc);
+			free(w.refdest);
+			free(w.qsrc);
+			free(w.qdest);
+			free(w.names);
+			edgelist_kill(e);
+		}
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "batch.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_batch bench_batch.c batch.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Applies bursts of updates one by one and as batches.
+ *
+ * Usage: bench_batch [-n nodes] [-d degree] [burst ...]
+ *
+ * Two copies of a hub graph (default 20000 nodes with about 8 edges each)
+ * get the same bursts (default 1000, 10000 and 100000 operations) of
+ * edge inserts and deletes, with one node delete per thousand
+ * operations. One copy gets them through graph_insert_edge(),
+ * graph_delete_edge() and graph_delete_node(), the other through
+ * graph_batch_apply(). After every burst the edge sets of the two are
+ * compared. Prints one CSV row per burst.
+ */
+
+static int by_edge(const void *a, const void *b)
+{
+	const long long x = *(const long long *)a;
+	const long long y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Return the edges of g as sorted keys over the node numbers in the
+ * names, in a new array. Sets *m to their number.
+ */
+static long long *edge_keys(const graph *g, int *m)
+{
+	int count = graph_edgecount(g);
+	int *src = malloc((count + 1) * sizeof(int));
+	int *dest = malloc((count + 1) * sizeof(int));
+	int *num = malloc((graph_id_bound(g) + 1) * sizeof(int));
+	long long *key = malloc((count + 1) * sizeof(long long));
+
+	dlist *l = graph_nodes(g);
+	for (dlist_pos p = dlist_first(l); !dlist_is_end(l, p); p = dlist_next(l, p)) {
+		node *n = dlist_inspect(l, p);
+		num[graph_node_id(n)] = atoi(graph_node_name(n) + 1);
+	}
+	*m = graph_edges(g, src, dest);
+	for (int k = 0; k < *m; k++) {
+		key[k] = (long long)num[src[k]] << 32 | num[dest[k]];
+	}
+	qsort(key, *m, sizeof(long long), by_edge);
+	free(num);
+	free(dest);
+	free(src);
+	return key;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = 20000;
+	int degree = 8;
+	int bursts[32];
+	int nbursts = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+			degree = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nbursts < 32) {
+			bursts[nbursts++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_batch [-n nodes] [-d degree] [burst ...]\n");
+			return -1;
+		}
+	}
+	if (nbursts == 0) {
+		bursts[nbursts++] = 1000;
+		bursts[nbursts++] = 10000;
+		bursts[nbursts++] = 100000;
+	}
+
+	edgelist *e = gen_hub(n, degree, 3);
+	node **one = malloc(n * sizeof(node *));
+	node **many = malloc(n * sizeof(node *));
+	graph *g1 = gen_graph(e, false, one);
+	graph *g2 = gen_graph(e, false, many);
+	bool *dead = calloc(n, sizeof(bool));
+	int *op = NULL;
+	graph_batch *b = graph_batch_empty();
+	unsigned long long state = 5;
+	bool ok = true;
+
+	printf("burst,edges,one_by_one_ms,batch_ms,cancelled,version_steps_one_by_one,version_steps_batch,mismatches\n");
+	for (int r = 0; r < nbursts; r++) {
+		int len = bursts[r];
+		op = realloc(op, 3 * len * sizeof(int));
+		// Half deletes of edges that are likely there, half inserts.
+		for (int k = 0; k < len; k++) {
+			int i = gen_rand(&state) % e->edgecount;
+			int kind = k % 1000 == 999 ? 2 : gen_rand(&state) % 2;
+			int u = kind == 0 ? (int)(gen_rand(&state) % n) : e->src[i];
+			int v = kind == 0 ? (int)(gen_rand(&state) % n) : e->dest[i];
+			if (dead[u] || dead[v]) {
+				kind = -1;
+			} else if (kind == 2) {
+				dead[u] = true;
+			}
+			op[3 * k] = kind;
+			op[3 * k + 1] = u;
+			op[3 * k + 2] = v;
+		}
+
+		long v1 = graph_version(g1);
+		long long t0 = timer_now();
+		for (int k = 0; k < len; k++) {
+			node *u = one[op[3 * k + 1]];
+			node *v = one[op[3 * k + 2]];
+			if (op[3 * k] == 0) {
+				g1 = graph_insert_edge(g1, u, v);
+			} else if (op[3 * k] == 1) {
+				g1 = graph_delete_edge(g1, u, v);
+			} else if (op[3 * k] == 2) {
+				g1 = graph_delete_node(g1, u);
+			}
+		}
+		double ms1 = (timer_now() - t0) / 1e6;
+		v1 = graph_version(g1) - v1;
+
+		long v2 = graph_version(g2);
+		t0 = timer_now();
+		graph_batch_clear(b);
+		for (int k = 0; k < len; k++) {
+			node *u = many[op[3 * k + 1]];
+			node *v = many[op[3 * k + 2]];
+			if (op[3 * k] == 0) {
+				graph_batch_insert_edge(b, u, v);
+			} else if (op[3 * k] == 1) {
+				graph_batch_delete_edge(b, u, v);
+			} else if (op[3 * k] == 2) {
+				graph_batch_delete_node(b, u);
+			}
+		}
+		g2 = graph_batch_apply(g2, b);
+		double ms2 = (timer_now() - t0) / 1e6;
+		v2 = graph_version(g2) - v2;
+
+		int m1;
+		int m2;
+		long long *k1 = edge_keys(g1, &m1);
+		long long *k2 = edge_keys(g2, &m2);
+		int mismatches = abs(m1 - m2) + abs(graph_nodecount(g1) - graph_nodecount(g2));
+		for (int k = 0; k < m1 && k < m2; k++) {
+			mismatches += k1[k] != k2[k];
+		}
+		free(k1);
+		free(k2);
+		printf("%d,%d,%.3f,%.3f,%d,%ld,%ld,%d\n", len, m2, ms1, ms2,
+			b->cancelled, v1, v2, mismatches);
+		fflush(stdout);
+		ok = ok && mismatches == 0;
+	}
+
+	graph_batch_kill(b);
+	graph_kill(g1);
+	graph_kill(g2);
+	free(op);
+	free(dead);
+	free(many);
+	free(one);
+	edgelist_kill(e);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "traverse.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_bitbfs bench_bitbfs.c gen.c cgraph.c traverse.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for the bit-parallel batch search.
+ *
+ * Usage: bench_bitbfs [-q queries] [size ...]
+ *
+ * For every generator (random, hub, grid) and size (default 100000
+ * nodes) the same random queries (default 4096) are answered one by one
+ * with trav_reach() and together with trav_reach_batch(). Then the same
+ * is done for full sweeps from a quarter as many sources, which look for
+ * no node and cover everything reachable. The answers are compared. One
+ * CSV row per graph and kind of query.
+ */
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	int sizes[32];
+	int nsizes = 0;
+	int queries = 4096;
+	unsigned long long state = 31;
+	bool ok = true;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			queries = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_bitbfs [-q queries] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 100000;
+	}
+
+	int *src = malloc((queries + 1) * sizeof(int));
+	int *dest = malloc((queries + 1) * sizeof(int));
+	bool *one = malloc((queries + 1) * sizeof(bool));
+	bool *batch = malloc((queries + 1) * sizeof(bool));
+
+	printf("generator,nodes,edges,kind,queries,found,one_by_one_ms,batch_ms,mismatches\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int g = 0; g < 3; g++) {
+			edgelist *e = gen_by_name(gens[g], sizes[s], 41 + s);
+			cgraph *c = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+			trav *t = trav_empty(c->nodecount);
+			for (int sweep = 0; sweep < 2; sweep++) {
+				int q = sweep ? queries / 4 : queries;
+				for (int i = 0; i < q; i++) {
+					src[i] = gen_rand(&state) % c->nodecount;
+					dest[i] = sweep ? -1 : (int)(gen_rand(&state) % c->nodecount);
+				}
+
+				long long t0 = timer_now();
+				for (int i = 0; i < q; i++) {
+					one[i] = trav_reach(t, c, src[i], dest[i]);
+				}
+				double ms1 = (timer_now() - t0) / 1e6;
+
+				t0 = timer_now();
+				trav_reach_batch(t, c, src, dest, q, batch);
+				double ms2 = (timer_now() - t0) / 1e6;
+
+				int found = 0;
+				int mismatches = 0;
+				for (int i = 0; i < q; i++) {
+					found += one[i];
+					mismatches += one[i] != batch[i];
+				}
+				printf("%s,%d,%d,%s,%d,%d,%.3f,%.3f,%d\n", gens[g],
+					c->nodecount, c->edgecount, sweep ? "sweep" : "pair", q,
+					found, ms1, ms2, mismatches);
+				fflush(stdout);
+				ok = ok && mismatches == 0;
+			}
+			trav_kill(t);
+			cgraph_kill(c);
+			edgelist_kill(e);
+		}
+	}
+
+	free(batch);
+	free(one);
+	free(dest);
+	free(src);
+	return ok ? 0 : 1;
+}
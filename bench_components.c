@@ -0,0 +1,90 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "components.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -pthread -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_components bench_components.c components.c gen.c cgraph.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Compares the sequential union-find baseline for connected components
+ * with Afforest on different numbers of threads.
+ *
+ * Usage: bench_components [-n nodes] [threads ...]
+ *
+ * The graphs are the random, hub and grid generators (default 1000000
+ * nodes) and a sparse random graph with half as many edges as nodes,
+ * which falls apart in many components. Every thread count (default 1,
+ * 2 and 4) is run on every graph, and its labels are compared with the
+ * union-find labels; the mismatches column counts nodes that differ.
+ * Prints one CSV row per graph and thread count.
+ */
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid", "sparse" };
+	int n = 1000000;
+	int threads[32];
+	int nthreads = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nthreads < 32) {
+			threads[nthreads++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_components [-n nodes] [threads ...]\n");
+			return -1;
+		}
+	}
+	if (nthreads == 0) {
+		threads[nthreads++] = 1;
+		threads[nthreads++] = 2;
+		threads[nthreads++] = 4;
+	}
+
+	bool ok = true;
+	printf("generator,nodes,edges,components,largest,threads,union_find_ms,afforest_ms,mismatches\n");
+	for (int g = 0; g < 4; g++) {
+		edgelist *e = g < 3 ? gen_by_name(gens[g], n, 53)
+			: gen_random(n, n / 2, 53);
+		cgraph *c = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+
+		long long t0 = timer_now();
+		components *base = components_union_find(c);
+		double ms1 = (timer_now() - t0) / 1e6;
+		int largest = 0;
+		for (int k = 0; k < base->count; k++) {
+			largest = base->size[k] > largest ? base->size[k] : largest;
+		}
+
+		for (int t = 0; t < nthreads; t++) {
+			t0 = timer_now();
+			components *cc = components_afforest(c, threads[t]);
+			double ms2 = (timer_now() - t0) / 1e6;
+
+			int mismatches = abs(cc->count - base->count);
+			for (int v = 0; v < c->nodecount; v++) {
+				mismatches += cc->label[v] != base->label[v];
+			}
+			for (int k = 0; k < cc->count && k < base->count; k++) {
+				mismatches += cc->size[k] != base->size[k];
+			}
+			printf("%s,%d,%d,%d,%d,%d,%.3f,%.3f,%d\n", gens[g], c->nodecount,
+				c->edgecount, base->count, largest, threads[t], ms1, ms2,
+				mismatches);
+			fflush(stdout);
+			ok = ok && mismatches == 0;
+			components_kill(cc);
+		}
+
+		components_kill(base);
+		cgraph_kill(c);
+		edgelist_kill(e);
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "zgraph.h"
+#include "traverse.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_compress bench_compress.c gen.c zgraph.c cgraph.c traverse.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for the compressed adjacency.
+ *
+ * Usage: bench_compress [-s sweeps] [size ...]
+ *
+ * For every generator graph, with random node ids and after a BFS
+ * renumbering, compares the out-list memory of the compact graph with
+ * the compressed one and times the same BFS sweeps on both. Writes one
+ * CSV row per graph and order. Every sweep is checked to reach the same
+ * number of nodes on both.
+ */
+
+/* Bytes used by the out-lists of a compact graph. */
+static size_t cgraph_out_bytes(const cgraph *c)
+{
+	return (c->nodecount + 1) * sizeof(int) + (size_t)c->edgecount * sizeof(int);
+}
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	int sizes[32];
+	int nsizes = 0;
+	int sweeps = 10;
+	int bad = 0;
+	unsigned long long state = 99;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+			sweeps = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_compress [-s sweeps] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 1 << 20;
+	}
+
+	printf("generator,nodes,edges,order,csr_bytes_per_edge,z_bytes_per_edge,"
+		"compress_ms,csr_sweep_ms,z_sweep_ms\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int g = 0; g < 3; g++) {
+			edgelist *e = gen_by_name(gens[g], sizes[s], state + s);
+			cgraph *base = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+			int n = base->nodecount;
+			edgelist_kill(e);
+
+			int *perm = malloc(n * sizeof(int));
+			for (int v = 0; v < n; v++) {
+				perm[v] = v;
+			}
+			for (int v = n - 1; v > 0; v--) {
+				int j = gen_rand(&state) % (v + 1);
+				int t = perm[v];
+				perm[v] = perm[j];
+				perm[j] = t;
+			}
+			cgraph *c = cgraph_permute(base, perm);
+			cgraph_kill(base);
+			free(perm);
+
+			for (int o = 0; o < 2; o++) {
+				if (o == 1) {
+					perm = cgraph_order(c, CGRAPH_ORDER_BFS);
+					cgraph *r = cgraph_permute(c, perm);
+					free(perm);
+					cgraph_kill(c);
+					c = r;
+				}
+				long long t0 = timer_now();
+				zgraph *z = zgraph_compress(c, false);
+				long long t1 = timer_now();
+
+				trav *t = trav_empty(n);
+				long long csr = 0;
+				long long zip = 0;
+				for (int i = 0; i < sweeps; i++) {
+					int src = gen_rand(&state) % n;
+					long long a = timer_now();
+					// Dest -1 never matches, so the whole reachable set is walked.
+					trav_reach(t, c, src, -1);
+					long long b = timer_now();
+					trav_reach_z(t, z, src, -1);
+					long long d = timer_now();
+					csr += b - a;
+					zip += d - b;
+				}
+				trav_kill(t);
+
+				// Spot check: decoding gives back the exact lists.
+				for (int v = 0; v < n; v += 1 + n / 1000) {
+					zgraph_iter it;
+					int w;
+					int k = c->out_off[v];
+					zgraph_out(z, v, &it);
+					while (zgraph_next(&it, &w)) {
+						bad += k >= c->out_off[v + 1] || c->out[k++] != w;
+					}
+					bad += k != c->out_off[v + 1];
+				}
+
+				size_t zbytes = zgraph_size(z) - sizeof(zgraph);
+				printf("%s,%d,%d,%s,%.2f,%.2f,%.3f,%.3f,%.3f\n", gens[g], n,
+					c->edgecount, o ? "bfs" : "random",
+					(double)cgraph_out_bytes(c) / c->edgecount,
+					(double)zbytes / c->edgecount, (t1 - t0) / 1e6,
+					csr / 1e6, zip / 1e6);
+				fflush(stdout);
+				zgraph_kill(z);
+			}
+			cgraph_kill(c);
+		}
+	}
+	if (bad) {
+		fprintf(stderr, "%d decoding mismatches\n", bad);
+	}
+	return bad != 0;
+}
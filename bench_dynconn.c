@@ -0,0 +1,203 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "path.h"
+#include "dynconn.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_dynconn bench_dynconn.c dynconn.c path.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c
+
+/*
+ * Answers path queries between random edge inserts and deletes with and
+ * without the dynamic connectivity layer.
+ *
+ * Usage: bench_dynconn [-n nodes] [-q queries] [every ...]
+ *
+ * The graph is a sparse random graph (default 2000 nodes), once with
+ * one-way edges and once with every edge in both directions, where
+ * dynconn_find_path() needs no search. Random node pairs are queried
+ * (default 10000 queries) and after every "every" queries (default
+ * 1000, 100, 10 and 1) an edge is inserted or deleted. The same traffic
+ * is answered by find_path() on one copy of the graph and by
+ * dynconn_find_path() on another. On a third copy dynconn_connected() is
+ * compared with a union-find built from scratch for every query, which is
+ * not timed. The mismatches column counts answers that differ. Prints one
+ * CSV row per graph and update rate.
+ */
+
+/*
+ * Apply update op (1 insert, 2 delete) of the edge from u to v, and of
+ * the edge back if both is set, through dc or straight to g if dc is
+ * NULL.
+ */
+static graph *apply(graph *g, dynconn *dc, int op, node *u, node *v,
+	bool both)
+{
+	for (int k = 0; k < (both ? 2 : 1); k++) {
+		node *a = k == 0 ? u : v;
+		node *b = k == 0 ? v : u;
+		if (op == 1) {
+			g = dc != NULL ? dynconn_insert_edge(dc, g, a, b)
+				: graph_insert_edge(g, a, b);
+		} else if (op == 2) {
+			g = dc != NULL ? dynconn_delete_edge(dc, g, a, b)
+				: graph_delete_edge(g, a, b);
+		}
+	}
+	return g;
+}
+
+static int uf_find(int *parent, int x)
+{
+	while (parent[x] != x) {
+		parent[x] = parent[parent[x]];
+		x = parent[x];
+	}
+	return x;
+}
+
+/* Return true if u and v are in the same component of g, from scratch. */
+static bool fresh_connected(const graph *g, const node *u, const node *v)
+{
+	int bound = graph_id_bound(g);
+	int m = graph_edgecount(g);
+	int *parent = malloc((bound + 1) * sizeof(int));
+	int *src = malloc((m + 1) * sizeof(int));
+	int *dest = malloc((m + 1) * sizeof(int));
+	for (int i = 0; i < bound; i++) {
+		parent[i] = i;
+	}
+	graph_edges(g, src, dest);
+	for (int i = 0; i < m; i++) {
+		parent[uf_find(parent, src[i])] = uf_find(parent, dest[i]);
+	}
+	bool same = uf_find(parent, graph_node_id(u))
+		== uf_find(parent, graph_node_id(v));
+	free(dest);
+	free(src);
+	free(parent);
+	return same;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = 2000;
+	int queries = 10000;
+	int every[32];
+	int nevery = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			queries = atoi(argv[++i]);
+		} else if (atoi(argv[i]) >= 0 && isdigit((unsigned char)argv[i][0]) && nevery < 32) {
+			every[nevery++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_dynconn [-n nodes] [-q queries] [every ...]\n");
+			return -1;
+		}
+	}
+	if (n < 2 || queries < 1) {
+		fprintf(stderr, "Usage: bench_dynconn [-n nodes] [-q queries] [every ...]\n");
+		return -1;
+	}
+	if (nevery == 0) {
+		every[nevery++] = 1000;
+		every[nevery++] = 100;
+		every[nevery++] = 10;
+		every[nevery++] = 1;
+	}
+
+	edgelist *e = gen_random(n, n, 27);
+	int *query = malloc(2 * queries * sizeof(int));
+	int *op = malloc(3 * queries * sizeof(int));
+	bool *one = malloc(queries * sizeof(bool));
+	node **nodes1 = malloc(n * sizeof(node *));
+	node **nodes2 = malloc(n * sizeof(node *));
+	node **nodes3 = malloc(n * sizeof(node *));
+	unsigned long long state = 27;
+	bool ok = true;
+
+	printf("graph,every,queries,updates,find_path_ms,dynconn_ms,mismatches\n");
+	for (int both = 0; both < 2; both++) {
+		for (int r = 0; r < nevery; r++) {
+			int updates = 0;
+			for (int k = 0; k < queries; k++) {
+				query[2 * k] = gen_rand(&state) % n;
+				query[2 * k + 1] = gen_rand(&state) % n;
+				op[3 * k] = 0;
+				op[3 * k + 1] = 0;
+				op[3 * k + 2] = 0;
+				if (every[r] > 0 && k % every[r] == every[r] - 1) {
+					// Even updates insert a random edge, odd ones delete one
+					// that is likely there.
+					int i = gen_rand(&state) % e->edgecount;
+					op[3 * k] = updates % 2 ? 2 : 1;
+					op[3 * k + 1] = updates % 2 ? e->src[i] : (int)(gen_rand(&state) % n);
+					op[3 * k + 2] = updates % 2 ? e->dest[i] : (int)(gen_rand(&state) % n);
+					updates++;
+				}
+			}
+
+			graph *g1 = gen_graph(e, both, nodes1);
+			long long t0 = timer_now();
+			for (int k = 0; k < queries; k++) {
+				one[k] = find_path(g1, nodes1[query[2 * k]], nodes1[query[2 * k + 1]]);
+				g1 = apply(g1, NULL, op[3 * k], nodes1[op[3 * k + 1]],
+					nodes1[op[3 * k + 2]], both);
+			}
+			double ms1 = (timer_now() - t0) / 1e6;
+
+			int mismatches = 0;
+			graph *g2 = gen_graph(e, both, nodes2);
+			t0 = timer_now();
+			dynconn *dc = dynconn_build(g2);
+			for (int k = 0; k < queries; k++) {
+				mismatches += dynconn_find_path(dc, g2, nodes2[query[2 * k]],
+					nodes2[query[2 * k + 1]]) != one[k];
+				g2 = apply(g2, dc, op[3 * k], nodes2[op[3 * k + 1]],
+					nodes2[op[3 * k + 2]], both);
+			}
+			double ms2 = (timer_now() - t0) / 1e6;
+			dynconn_kill(dc);
+
+			graph *g3 = gen_graph(e, both, nodes3);
+			dc = dynconn_build(g3);
+			for (int k = 0; k < queries; k++) {
+				node *u = nodes3[query[2 * k]];
+				node *v = nodes3[query[2 * k + 1]];
+				bool same = dynconn_connected(dc, g3, u, v);
+				if (same != fresh_connected(g3, u, v) || (one[k] && !same)) {
+					mismatches++;
+				}
+				g3 = apply(g3, dc, op[3 * k], nodes3[op[3 * k + 1]],
+					nodes3[op[3 * k + 2]], both);
+			}
+			dynconn_kill(dc);
+
+			printf("%s,%d,%d,%d,%.3f,%.3f,%d\n", both ? "symmetric" : "directed",
+				every[r], queries, updates, ms1, ms2, mismatches);
+			fflush(stdout);
+			ok = ok && mismatches == 0;
+			graph_kill(g1);
+			graph_kill(g2);
+			graph_kill(g3);
+		}
+	}
+
+	free(nodes3);
+	free(nodes2);
+	free(nodes1);
+	free(one);
+	free(op);
+	free(query);
+	edgelist_kill(e);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "traverse.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_hops bench_hops.c gen.c cgraph.c traverse.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for hop-limited searches.
+ *
+ * Usage: bench_hops [-q queries] [size ...]
+ *
+ * For every generator (random, hub, grid), size (default 200000 nodes)
+ * and hop limit (2, 3, 6 and none) the same random queries (default
+ * 1000) are answered with trav_reach(), which ignores the limit,
+ * trav_hops() and trav_hops_bidir(). The two hop searches must agree,
+ * and a node within the limit must also be found by trav_reach() and by
+ * trav_reach_set() with the same limit. One CSV row per case.
+ */
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	static const int limits[] = { 2, 3, 6, TRAV_NO_LIMIT };
+	int sizes[32];
+	int nsizes = 0;
+	int queries = 1000;
+	unsigned long long state = 77;
+	bool ok = true;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			queries = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_hops [-q queries] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 200000;
+	}
+
+	int *src = malloc((queries + 1) * sizeof(int));
+	int *dest = malloc((queries + 1) * sizeof(int));
+	bool *reach = malloc((queries + 1) * sizeof(bool));
+	int *hops = malloc((queries + 1) * sizeof(int));
+
+	printf("generator,nodes,edges,limit,queries,within,reach_ms,hops_ms,bidir_ms,mismatches\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int g = 0; g < 3; g++) {
+			edgelist *e = gen_by_name(gens[g], sizes[s], 5 + s);
+			cgraph *c = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+			trav *t = trav_empty(c->nodecount);
+			for (int i = 0; i < queries; i++) {
+				src[i] = gen_rand(&state) % c->nodecount;
+				dest[i] = gen_rand(&state) % c->nodecount;
+			}
+			long long t0 = timer_now();
+			for (int i = 0; i < queries; i++) {
+				reach[i] = trav_reach(t, c, src[i], dest[i]);
+			}
+			double reach_ms = (timer_now() - t0) / 1e6;
+
+			for (int l = 0; l < 4; l++) {
+				t0 = timer_now();
+				for (int i = 0; i < queries; i++) {
+					hops[i] = trav_hops(t, c, src[i], dest[i], limits[l]);
+				}
+				double hops_ms = (timer_now() - t0) / 1e6;
+
+				int mismatches = 0;
+				t0 = timer_now();
+				for (int i = 0; i < queries; i++) {
+					mismatches += hops[i] != trav_hops_bidir(t, c, src[i],
+						dest[i], limits[l]);
+				}
+				double bidir_ms = (timer_now() - t0) / 1e6;
+
+				int within = 0;
+				for (int i = 0; i < queries; i++) {
+					within += hops[i] >= 0;
+					mismatches += hops[i] >= 0 && !reach[i];
+					mismatches += limits[l] == TRAV_NO_LIMIT && reach[i] != (hops[i] >= 0);
+				}
+				// Spot check the levels of trav_reach_set().
+				for (int i = 0; i < queries && i < 20; i++) {
+					int levels;
+					trav_reach_set(t, c, &src[i], 1, limits[l]);
+					const int *level = trav_reached_levels(t, &levels);
+					int count;
+					const int *reached = trav_reached(t, &count);
+					int at = -1;
+					for (int h = 0; h < levels; h++) {
+						for (int k = level[h]; k < level[h + 1]; k++) {
+							if (reached[k] == dest[i]) {
+								at = h;
+							}
+						}
+					}
+					mismatches += at != hops[i];
+				}
+				printf("%s,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%d\n", gens[g],
+					c->nodecount, c->edgecount, limits[l], queries, within,
+					reach_ms, hops_ms, bidir_ms, mismatches);
+				fflush(stdout);
+				ok = ok && mismatches == 0;
+			}
+			trav_kill(t);
+			cgraph_kill(c);
+			edgelist_kill(e);
+		}
+	}
+
+	free(hops);
+	free(reach);
+	free(dest);
+	free(src);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "ingest.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -pthread -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_ingest bench_ingest.c ingest.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Loads a map file with ingest_map() and different numbers of threads.
+ *
+ * Usage: bench_ingest [-n nodes] [-m edges] [threads ...]
+ *
+ * A random graph (default 200000 nodes and 1000000 edges) is written to
+ * a temporary file in the map file format and loaded once per thread
+ * count (default 1, 2, 4 and 8). Every load is checked against the
+ * generated edge list. Prints one CSV row per load.
+ */
+
+static int by_edge(const void *a, const void *b)
+{
+	const long long x = *(const long long *)a;
+	const long long y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+/* Return the number of edges of g that are not in the sorted key. */
+static long check(const graph *g, const long long *key, int m)
+{
+	int count = graph_edgecount(g);
+	int *src = malloc((count + 1) * sizeof(int));
+	int *dest = malloc((count + 1) * sizeof(int));
+	int *num = malloc((graph_id_bound(g) + 1) * sizeof(int));
+	long bad = count != m;
+
+	dlist *l = graph_nodes(g);
+	for (dlist_pos p = dlist_first(l); !dlist_is_end(l, p); p = dlist_next(l, p)) {
+		node *n = dlist_inspect(l, p);
+		num[graph_node_id(n)] = atoi(graph_node_name(n) + 1);
+	}
+	count = graph_edges(g, src, dest);
+	for (int k = 0; k < count; k++) {
+		long long e = (long long)num[src[k]] << 32 | num[dest[k]];
+		bad += bsearch(&e, key, m, sizeof(long long), by_edge) == NULL;
+	}
+	free(num);
+	free(dest);
+	free(src);
+	return bad;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = 200000;
+	int m = 1000000;
+	int threads[32];
+	int nthreads = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+			m = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nthreads < 32) {
+			threads[nthreads++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_ingest [-n nodes] [-m edges] [threads ...]\n");
+			return -1;
+		}
+	}
+	if (nthreads == 0) {
+		for (int t = 1; t <= 8; t *= 2) {
+			threads[nthreads++] = t;
+		}
+	}
+
+	edgelist *e = gen_random(n, m, 11);
+	FILE *f = tmpfile();
+	if (f == NULL) {
+		perror("tmpfile");
+		return -1;
+	}
+	fprintf(f, "# bench_ingest\n%d\n", e->edgecount);
+	long long *key = malloc((e->edgecount + 1) * sizeof(long long));
+	for (int i = 0; i < e->edgecount; i++) {
+		fprintf(f, "N%d N%d\n", e->src[i], e->dest[i]);
+		key[i] = (long long)e->src[i] << 32 | e->dest[i];
+	}
+	qsort(key, e->edgecount, sizeof(long long), by_edge);
+
+	bool ok = true;
+	printf("threads,nodes,edges,load_ms,mismatches\n");
+	for (int t = 0; t < nthreads; t++) {
+		rewind(f);
+		long long t0 = timer_now();
+		graph *g = ingest_map(f, "bench_ingest", threads[t]);
+		double ms = (timer_now() - t0) / 1e6;
+		if (g == NULL) {
+			return 1;
+		}
+		long bad = check(g, key, e->edgecount);
+		printf("%d,%d,%d,%.3f,%ld\n", threads[t], graph_nodecount(g),
+			graph_edgecount(g), ms, bad);
+		fflush(stdout);
+		ok = ok && bad == 0;
+		graph_kill(g);
+	}
+	fclose(f);
+	free(key);
+	edgelist_kill(e);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "traverse.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_multi bench_multi.c gen.c cgraph.c traverse.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for multi-source reachability sets.
+ *
+ * Usage: bench_multi [-g generator] [-n nodes]
+ *
+ * For 1, 8, 64 and 512 random sources and hop limits of 1, 2, 4 and
+ * none, the reached set is found once with a single trav_reach_set()
+ * over all sources and once as the union of one trav_reach_set() per
+ * source. Both use the same buffers for every search. The two bitsets
+ * are compared; the mismatches column counts nodes where they differ.
+ * One CSV row per case.
+ */
+
+int main(int argc, char const *argv[])
+{
+	static const int nsources[] = { 1, 8, 64, 512 };
+	static const int hops[] = { 1, 2, 4, TRAV_NO_LIMIT };
+	const char *gen = "random";
+	int n = 200000;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+			gen = argv[++i];
+		} else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else {
+			fprintf(stderr, "Usage: bench_multi [-g generator] [-n nodes]\n");
+			return -1;
+		}
+	}
+	edgelist *e = gen_by_name(gen, n, 17);
+	if (e == NULL || e->nodecount == 0) {
+		fprintf(stderr, "Unknown generator %s\n", gen);
+		return -1;
+	}
+	cgraph *c = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+	int words = (c->nodecount + 63) / 64;
+	unsigned long long *multi = malloc(words * sizeof(unsigned long long));
+	unsigned long long *single = malloc(words * sizeof(unsigned long long));
+	unsigned long long *one = malloc(words * sizeof(unsigned long long));
+	int *src = malloc(512 * sizeof(int));
+	trav *t = trav_empty(c->nodecount);
+	unsigned long long state = 23;
+	bool ok = true;
+
+	printf("generator,nodes,edges,sources,hops,reached,multi_ms,separate_ms,mismatches\n");
+	for (int s = 0; s < 4; s++) {
+		for (int i = 0; i < nsources[s]; i++) {
+			src[i] = gen_rand(&state) % c->nodecount;
+		}
+		for (int h = 0; h < 4; h++) {
+			long long t0 = timer_now();
+			int reached = trav_reach_set(t, c, src, nsources[s], hops[h]);
+			trav_reached_bits(t, multi);
+			double ms1 = (timer_now() - t0) / 1e6;
+
+			t0 = timer_now();
+			memset(single, 0, words * sizeof(unsigned long long));
+			for (int i = 0; i < nsources[s]; i++) {
+				trav_reach_set(t, c, &src[i], 1, hops[h]);
+				trav_reached_bits(t, one);
+				for (int w = 0; w < words; w++) {
+					single[w] |= one[w];
+				}
+			}
+			double ms2 = (timer_now() - t0) / 1e6;
+
+			int mismatches = 0;
+			for (int w = 0; w < words; w++) {
+				mismatches += __builtin_popcountll(multi[w] ^ single[w]);
+			}
+			printf("%s,%d,%d,%d,%d,%d,%.3f,%.3f,%d\n", gen, c->nodecount,
+				c->edgecount, nsources[s], hops[h], reached, ms1, ms2,
+				mismatches);
+			fflush(stdout);
+			ok = ok && mismatches == 0;
+		}
+	}
+
+	trav_kill(t);
+	free(src);
+	free(one);
+	free(single);
+	free(multi);
+	cgraph_kill(c);
+	edgelist_kill(e);
+	return ok ? 0 : 1;
+}
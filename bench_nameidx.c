@@ -0,0 +1,234 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "cgraph.h"
+#include "nameidx.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_nameidx bench_nameidx.c nameidx.c cgraph.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Compares name lookup through graph_try_find_node() with the perfect
+ * hash name index.
+ *
+ * Usage: bench_nameidx [-q lookups] [size ...]
+ *
+ * For every size (default 1000, 10000 and 100000 nodes) a random graph
+ * with four letter airport-like names is built and frozen, and the name
+ * index is built over it. The same random names, a tenth of them not in
+ * the graph, are looked up with both (default 1000 lookups, since
+ * graph_try_find_node() walks the node list). The index is then saved to
+ * a temporary file and loaded back. A mismatch is a lookup that gives
+ * another node than graph_try_find_node(), or a name, edge or lookup
+ * that differs after loading. Finally a truncated copy of the file and
+ * files with edge offsets out of range, a pool size past the end of the
+ * file and an empty pool must fail to load; each that loads counts as a
+ * mismatch too. Prints one CSV row per size.
+ */
+
+/*
+ * Write an index file for two nodes and one edge, with out-edge offsets
+ * {0, mid, 1} and the given pool size. With mid past 1 the first node
+ * claims edges that are not there; a pool size past the end of the file
+ * claims names that are not there.
+ */
+static void write_bad(FILE *f, int mid, size_t poolsize)
+{
+	int head[3] = { 2, 1, 1 };
+	unsigned long long seed = 1;
+	int off[3] = { 0, mid, 1 };
+	int dest[1] = { 1 };
+	unsigned disp[1] = { 0 };
+	int id[2] = { 0, 1 };
+
+	fwrite("OU5NIDX1", 1, 8, f);
+	fwrite(head, sizeof(int), 3, f);
+	fwrite(&seed, sizeof(seed), 1, f);
+	fwrite(&poolsize, sizeof(poolsize), 1, f);
+	fwrite(off, sizeof(int), 3, f);
+	fwrite(dest, sizeof(int), 1, f);
+	fwrite(disp, sizeof(unsigned), 1, f);
+	fwrite(id, sizeof(int), 2, f);
+	fwrite("A\0B\0", 1, 4, f);
+}
+
+/* Return 1 if the first len bytes of src load as an index, otherwise 0. */
+static int loads(FILE *src, long len)
+{
+	FILE *f = tmpfile();
+	if (f == NULL) {
+		return 1;
+	}
+	rewind(src);
+	for (long i = 0; i < len; i++) {
+		fputc(fgetc(src), f);
+	}
+	rewind(f);
+	cgraph *c = NULL;
+	nameidx *x = nameidx_load(f, &c);
+	fclose(f);
+	if (x == NULL) {
+		return c != NULL;
+	}
+	nameidx_kill(x);
+	cgraph_kill(c);
+	return 1;
+}
+
+/* Return 1 if the file made by write_bad() loads as an index. */
+static int loads_bad(int mid, size_t poolsize)
+{
+	FILE *f = tmpfile();
+	if (f == NULL) {
+		return 1;
+	}
+	write_bad(f, mid, poolsize);
+	int r = loads(f, ftell(f));
+	fclose(f);
+	return r;
+}
+
+static void code(int i, char *name)
+{
+	for (int k = 0; k < 4; k++) {
+		name[k] = 'A' + i % 26;
+		i /= 26;
+	}
+	sprintf(name + 4, "%d", i);
+	if (i == 0) {
+		name[4] = '\0';
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	int sizes[32];
+	int nsizes = 0;
+	int lookups = 1000;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			lookups = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_nameidx [-q lookups] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 1000;
+		sizes[nsizes++] = 10000;
+		sizes[nsizes++] = 100000;
+	}
+
+	unsigned long long state = 37;
+	bool ok = true;
+	char (*names)[24] = malloc(lookups * sizeof(*names));
+	printf("nodes,lookups,build_ms,bytes,find_node_ns,nameidx_ns,mismatches\n");
+	for (int s = 0; s < nsizes; s++) {
+		int n = sizes[s];
+		edgelist *e = gen_random(n, 4 * n, 43 + s);
+		node **nodes = malloc(n * sizeof(node *));
+		char name[24];
+		graph *g = graph_empty(n);
+		for (int i = 0; i < n; i++) {
+			code(i, name);
+			g = graph_insert_node(g, name);
+			nodes[i] = graph_choose_node(g);
+		}
+		for (int i = 0; i < e->edgecount; i++) {
+			g = graph_insert_edge(g, nodes[e->src[i]], nodes[e->dest[i]]);
+		}
+		cgraph *c = cgraph_freeze(g);
+
+		long long t0 = timer_now();
+		nameidx *x = nameidx_build(c);
+		double build = (timer_now() - t0) / 1e6;
+		if (x == NULL) {
+			fprintf(stderr, "Could not build the name index\n");
+			return 1;
+		}
+
+		for (int i = 0; i < lookups; i++) {
+			int k = gen_rand(&state) % n;
+			code(k, names[i]);
+			if (i % 10 == 9) {
+				names[i][0] = 'a';
+			}
+		}
+		int mismatches = 0;
+		int *want = malloc(lookups * sizeof(int));
+		t0 = timer_now();
+		for (int i = 0; i < lookups; i++) {
+			node *nd = graph_try_find_node(g, names[i]);
+			want[i] = nd == NULL ? -1 : cgraph_id(c, nd);
+		}
+		double ns1 = (double)(timer_now() - t0) / lookups;
+
+		int rounds = 1000;
+		t0 = timer_now();
+		for (int r = 0; r < rounds; r++) {
+			for (int i = 0; i < lookups; i++) {
+				nameidx_find(x, names[i]);
+			}
+		}
+		double ns2 = (double)(timer_now() - t0) / ((double)rounds * lookups);
+		for (int i = 0; i < lookups; i++) {
+			mismatches += nameidx_find(x, names[i]) != want[i];
+		}
+		for (int v = 0; v < n; v++) {
+			mismatches += nameidx_find(x, graph_node_name(c->nodes[v])) != v;
+		}
+
+		FILE *f = tmpfile();
+		cgraph *c2 = NULL;
+		nameidx *x2 = NULL;
+		if (f != NULL && nameidx_save(x, c, f) == 0) {
+			rewind(f);
+			x2 = nameidx_load(f, &c2);
+		}
+		if (x2 == NULL) {
+			fprintf(stderr, "Could not save and load the name index\n");
+			return 1;
+		}
+		mismatches += loads(f, ftell(f) / 2);
+		mismatches += loads_bad(100, 4);
+		mismatches += loads_bad(1, (size_t)-1);
+		mismatches += loads_bad(1, 0);
+		fclose(f);
+		mismatches += c2->nodecount != c->nodecount || c2->edgecount != c->edgecount;
+		for (int v = 0; v <= c->nodecount && !mismatches; v++) {
+			mismatches += c2->out_off[v] != c->out_off[v];
+		}
+		for (int i = 0; i < c->edgecount && !mismatches; i++) {
+			mismatches += c2->out[i] != c->out[i];
+		}
+		for (int v = 0; v < n; v++) {
+			mismatches += strcmp(nameidx_name(x2, v), nameidx_name(x, v)) != 0;
+		}
+		for (int i = 0; i < lookups; i++) {
+			mismatches += nameidx_find(x2, names[i]) != want[i];
+		}
+
+		printf("%d,%d,%.3f,%zu,%.1f,%.1f,%d\n", n, lookups, build,
+			nameidx_size(x), ns1, ns2, mismatches);
+		fflush(stdout);
+		ok = ok && mismatches == 0;
+		free(want);
+		nameidx_kill(x2);
+		cgraph_kill(c2);
+		nameidx_kill(x);
+		cgraph_kill(c);
+		graph_kill(g);
+		free(nodes);
+		edgelist_kill(e);
+	}
+	free(names);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "traverse.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_order bench_order.c gen.c cgraph.c traverse.c stats.c graph4.c log.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for the node orders of the compact graph.
+ *
+ * Usage: bench_order [-s sweeps] [size ...]
+ *
+ * Every generator graph is first given random node ids, which is what
+ * the node list of a graph built from a route feed looks like. It is
+ * then renumbered with each CGRAPH_ORDER_* order, and the same
+ * full-graph BFS sweeps are timed on every version. One CSV row per
+ * order gives the renumbering time, the sweep time and the speedup over
+ * the random ids.
+ */
+
+static int run_sweeps(const cgraph *c, const int *sources, int sweeps)
+{
+	trav *t = trav_empty(c->nodecount);
+	int found = 0;
+	for (int i = 0; i < sweeps; i++) {
+		// Dest -1 never matches, so the search covers everything reachable.
+		found += trav_reach(t, c, sources[i], -1);
+	}
+	trav_kill(t);
+	return found;
+}
+
+int main(int argc, char const *argv[])
+{
+	static const char *gens[] = { "random", "hub", "grid" };
+	static const char *orders[] = { "list", "bfs", "rcm", "degree" };
+	int sizes[32];
+	int nsizes = 0;
+	int sweeps = 20;
+	unsigned long long state = 4711;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+			sweeps = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_order [-s sweeps] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 1 << 20;
+	}
+
+	printf("generator,nodes,edges,order,reorder_ms,sweep_ms,speedup\n");
+	for (int s = 0; s < nsizes; s++) {
+		for (int g = 0; g < 3; g++) {
+			edgelist *e = gen_by_name(gens[g], sizes[s], state + s);
+			cgraph *base = cgraph_from_edges(e->nodecount, e->edgecount, e->src, e->dest);
+			int n = base->nodecount;
+			edgelist_kill(e);
+
+			// Random ids as the baseline.
+			int *perm = malloc(n * sizeof(int));
+			for (int v = 0; v < n; v++) {
+				perm[v] = v;
+			}
+			for (int v = n - 1; v > 0; v--) {
+				int j = gen_rand(&state) % (v + 1);
+				int t = perm[v];
+				perm[v] = perm[j];
+				perm[j] = t;
+			}
+			cgraph *shuffled = cgraph_permute(base, perm);
+			cgraph_kill(base);
+			free(perm);
+
+			int *sources = malloc(sweeps * sizeof(int));
+			int *mapped = malloc(sweeps * sizeof(int));
+			int *newid = malloc(n * sizeof(int));
+			for (int i = 0; i < sweeps; i++) {
+				sources[i] = gen_rand(&state) % n;
+			}
+
+			long long t0 = timer_now();
+			run_sweeps(shuffled, sources, sweeps);
+			long long baseline = timer_now() - t0;
+			printf("%s,%d,%d,random,0.000,%.3f,1.00\n", gens[g], n,
+				shuffled->edgecount, baseline / 1e6);
+
+			for (int o = 1; o < 4; o++) {
+				t0 = timer_now();
+				perm = cgraph_order(shuffled, o);
+				cgraph *c = cgraph_permute(shuffled, perm);
+				long long t1 = timer_now();
+				for (int k = 0; k < n; k++) {
+					newid[perm[k]] = k;
+				}
+				for (int i = 0; i < sweeps; i++) {
+					mapped[i] = newid[sources[i]];
+				}
+				long long t2 = timer_now();
+				run_sweeps(c, mapped, sweeps);
+				long long t3 = timer_now();
+				printf("%s,%d,%d,%s,%.3f,%.3f,%.2f\n", gens[g], n, c->edgecount,
+					orders[o], (t1 - t0) / 1e6, (t3 - t2) / 1e6,
+					(double)baseline / (t3 - t2));
+				fflush(stdout);
+				free(perm);
+				cgraph_kill(c);
+			}
+			free(sources);
+			free(mapped);
+			free(newid);
+			cgraph_kill(shuffled);
+		}
+	}
+	return 0;
+}
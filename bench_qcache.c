@@ -0,0 +1,174 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "path.h"
+#include "qcache.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_qcache bench_qcache.c qcache.c path.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c
+
+/*
+ * Answers skewed query traffic with and without the query cache.
+ *
+ * Usage: bench_qcache [-n nodes] [-q queries] [-p pairs] [every ...]
+ *
+ * Queries are drawn from a fixed list of popular pairs (default 1000)
+ * with Zipf weights, so a few pairs make up most of the traffic, on a
+ * sparse random graph (default 5000 nodes). After every "every" queries
+ * (default never, 1000 and 100) an edge is inserted or deleted. Every
+ * tenth change bypasses the cache, which must notice it through
+ * graph_version(). The same traffic is answered by find_path() on one
+ * copy of the graph and by qcache_find_path() on another, and the
+ * answers are compared. Prints one CSV row per update rate.
+ */
+
+/* Return the index of the first weight in cum that is above x. */
+static int pick(const double *cum, int n, double x)
+{
+	int lo = 0;
+	int hi = n - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (cum[mid] > x) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = 5000;
+	int queries = 20000;
+	int npairs = 1000;
+	int every[32];
+	int nevery = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			n = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			queries = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+			npairs = atoi(argv[++i]);
+		} else if (atoi(argv[i]) >= 0 && isdigit((unsigned char)argv[i][0]) && nevery < 32) {
+			every[nevery++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_qcache [-n nodes] [-q queries] [-p pairs] [every ...]\n");
+			return -1;
+		}
+	}
+	if (nevery == 0) {
+		every[nevery++] = 0;
+		every[nevery++] = 1000;
+		every[nevery++] = 100;
+	}
+
+	edgelist *e = gen_random(n, n, 19);
+	int *pair = malloc(2 * npairs * sizeof(int));
+	double *cum = malloc(npairs * sizeof(double));
+	int *query = malloc(queries * sizeof(int));
+	int *op = malloc(3 * queries * sizeof(int));
+	bool *one = malloc(queries * sizeof(bool));
+	node **nodes1 = malloc(n * sizeof(node *));
+	node **nodes2 = malloc(n * sizeof(node *));
+	unsigned long long state = 13;
+	double total = 0;
+	for (int i = 0; i < npairs; i++) {
+		pair[2 * i] = gen_rand(&state) % n;
+		pair[2 * i + 1] = gen_rand(&state) % n;
+		total += 1.0 / (i + 1);
+		cum[i] = total;
+	}
+	bool ok = true;
+
+	printf("every,queries,updates,pair_hits,set_hits,misses,stale,hit_rate,find_path_ms,qcache_ms,mismatches\n");
+	for (int r = 0; r < nevery; r++) {
+		int updates = 0;
+		for (int k = 0; k < queries; k++) {
+			query[k] = pick(cum, npairs, total * (gen_rand(&state) % 1000000) / 1e6);
+			if (every[r] > 0 && k % every[r] == every[r] - 1) {
+				// Even updates insert a random edge, odd ones delete one that
+				// is likely there.
+				int i = gen_rand(&state) % e->edgecount;
+				op[3 * k] = updates % 2 ? 2 : 1;
+				op[3 * k + 1] = updates % 2 ? e->src[i] : (int)(gen_rand(&state) % n);
+				op[3 * k + 2] = updates % 2 ? e->dest[i] : (int)(gen_rand(&state) % n);
+				updates++;
+			} else {
+				op[3 * k] = 0;
+				op[3 * k + 1] = 0;
+				op[3 * k + 2] = 0;
+			}
+		}
+
+		graph *g1 = gen_graph(e, false, nodes1);
+		graph *g2 = gen_graph(e, false, nodes2);
+		qcache *q = qcache_empty(4096, 64);
+
+		long long t0 = timer_now();
+		for (int k = 0; k < queries; k++) {
+			node *u = nodes1[pair[2 * query[k]]];
+			node *v = nodes1[pair[2 * query[k] + 1]];
+			one[k] = find_path(g1, u, v);
+			u = nodes1[op[3 * k + 1]];
+			v = nodes1[op[3 * k + 2]];
+			if (op[3 * k] == 1) {
+				g1 = graph_insert_edge(g1, u, v);
+			} else if (op[3 * k] == 2) {
+				g1 = graph_delete_edge(g1, u, v);
+			}
+		}
+		double ms1 = (timer_now() - t0) / 1e6;
+
+		int mismatches = 0;
+		int seen = 0;
+		t0 = timer_now();
+		for (int k = 0; k < queries; k++) {
+			node *u = nodes2[pair[2 * query[k]]];
+			node *v = nodes2[pair[2 * query[k] + 1]];
+			mismatches += qcache_find_path(q, g2, u, v) != one[k];
+			u = nodes2[op[3 * k + 1]];
+			v = nodes2[op[3 * k + 2]];
+			if (op[3 * k] != 0 && seen++ % 10 == 9) {
+				g2 = op[3 * k] == 1 ? graph_insert_edge(g2, u, v)
+					: graph_delete_edge(g2, u, v);
+			} else if (op[3 * k] == 1) {
+				g2 = qcache_insert_edge(q, g2, u, v);
+			} else if (op[3 * k] == 2) {
+				g2 = qcache_delete_edge(q, g2, u, v);
+			}
+		}
+		double ms2 = (timer_now() - t0) / 1e6;
+
+		struct qcache_stats s;
+		qcache_stats_get(q, &s);
+		printf("%d,%d,%d,%ld,%ld,%ld,%ld,%.3f,%.3f,%.3f,%d\n", every[r],
+			queries, updates, s.pair_hits, s.set_hits, s.misses, s.stale,
+			(double)(s.pair_hits + s.set_hits) / s.queries, ms1, ms2,
+			mismatches);
+		fflush(stdout);
+		ok = ok && mismatches == 0;
+		qcache_kill(q);
+		graph_kill(g1);
+		graph_kill(g2);
+	}
+
+	free(nodes2);
+	free(nodes1);
+	free(one);
+	free(op);
+	free(query);
+	free(cum);
+	free(pair);
+	edgelist_kill(e);
+	return ok ? 0 : 1;
+}
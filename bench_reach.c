@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "cgraph.h"
+#include "reach_index.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_reach bench_reach.c gen.c reach_index.c cgraph.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Benchmark for the reachability index. Builds a random directed graph,
+ * indexes it and compares the query latency of the index with a plain
+ * BFS over the compact graph. All results are printed as "key value"
+ * lines.
+ *
+ * Usage: bench_reach [nodes] [edges] [queries]
+ */
+
+/* Plain BFS over the compact graph, used as the reference answer. */
+static bool bfs_reach(const cgraph *c, int src, int dest, int *mark,
+	int stamp, int *queue)
+{
+	int head = 0;
+	int tail = 0;
+	queue[tail++] = src;
+	mark[src] = stamp;
+	while (head < tail) {
+		int u = queue[head++];
+		if (u == dest) {
+			return true;
+		}
+		for (int k = c->out_off[u]; k < c->out_off[u + 1]; k++) {
+			int w = c->out[k];
+			if (mark[w] != stamp) {
+				mark[w] = stamp;
+				queue[tail++] = w;
+			}
+		}
+	}
+	return false;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 2000;
+	int m = argc > 2 ? atoi(argv[2]) : 4 * n;
+	int q = argc > 3 ? atoi(argv[3]) : 100000;
+	unsigned long long state = 88172645463325252ULL;
+
+	edgelist *e = gen_random(n, m, state);
+	node **nodes = malloc(n * sizeof(node *));
+	graph *g = gen_graph(e, false, nodes);
+	edgelist_kill(e);
+
+	long long t0 = timer_now();
+	cgraph *c = cgraph_freeze(g);
+	long long t1 = timer_now();
+	reach_index *ri = reach_index_build(c);
+	long long t2 = timer_now();
+
+	int *src = malloc(q * sizeof(int));
+	int *dest = malloc(q * sizeof(int));
+	bool *expect = malloc(q * sizeof(bool));
+	for (int i = 0; i < q; i++) {
+		src[i] = gen_rand(&state) % n;
+		dest[i] = gen_rand(&state) % n;
+	}
+
+	int *mark = calloc(n, sizeof(int));
+	int *queue = malloc(n * sizeof(int));
+	long long t3 = timer_now();
+	for (int i = 0; i < q; i++) {
+		expect[i] = bfs_reach(c, src[i], dest[i], mark, i + 1, queue);
+	}
+	long long t4 = timer_now();
+	int hits = 0;
+	int wrong = 0;
+	for (int i = 0; i < q; i++) {
+		bool r = reach_index_query(ri, src[i], dest[i]);
+		hits += r;
+		wrong += r != expect[i];
+	}
+	long long t5 = timer_now();
+
+	printf("nodes %d\n", c->nodecount);
+	printf("edges %d\n", c->edgecount);
+	printf("freeze_ms %.3f\n", (t1 - t0) / 1e6);
+	printf("index_build_ms %.3f\n", (t2 - t1) / 1e6);
+	printf("index_labels %ld\n", reach_index_labels(ri));
+	printf("index_bytes %zu\n", reach_index_size(ri));
+	printf("queries %d\n", q);
+	printf("reachable %d\n", hits);
+	printf("bfs_query_ns %.1f\n", (double)(t4 - t3) / q);
+	printf("index_query_ns %.1f\n", (double)(t5 - t4) / q);
+	printf("mismatches %d\n", wrong);
+
+	free(src);
+	free(dest);
+	free(expect);
+	free(mark);
+	free(queue);
+	free(nodes);
+	reach_index_kill(ri);
+	cgraph_kill(c);
+	graph_kill(g);
+	return wrong != 0;
+}
@@ -0,0 +1,144 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "shortname.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_shortname bench_shortname.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Compares a strcmp() scan over an array of names with shortname_scan()
+ * over their packed forms.
+ *
+ * Usage: bench_shortname [-q lookups] [size ...]
+ *
+ * For every size (default 1000, 10000 and 100000 names) the names are
+ * four letter codes, then codes with a long common prefix, which are
+ * packed with a hash and checked with strcmp() after the packed compare.
+ * The same random names, a tenth of them not in the array, are looked up
+ * with both scans (default 1000 lookups). A mismatch is a lookup where
+ * the two find different indices. Prints one CSV row per size and kind
+ * of name.
+ */
+
+static void code(int i, bool longname, char *name)
+{
+	int at = 0;
+	if (longname) {
+		at = sprintf(name, "international_airport_");
+	}
+	for (int k = 0; k < 4; k++) {
+		name[at++] = 'A' + i % 26;
+		i /= 26;
+	}
+	sprintf(name + at, "%d", i);
+	if (i == 0) {
+		name[at] = '\0';
+	}
+}
+
+static int scan_strcmp(char (*names)[40], int n, const char *s)
+{
+	for (int i = 0; i < n; i++) {
+		if (!strcmp(names[i], s)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static int scan_packed(const shortname *keys, char (*names)[40], int n,
+	const char *s)
+{
+	shortname key;
+	bool whole = shortname_pack(s, &key);
+	for (int i = shortname_scan(keys, 0, n, &key); i >= 0;
+		i = shortname_scan(keys, i + 1, n, &key)) {
+		if (whole || !strcmp(names[i], s)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int main(int argc, char const *argv[])
+{
+	int sizes[32];
+	int nsizes = 0;
+	int lookups = 1000;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-q") && i + 1 < argc) {
+			lookups = atoi(argv[++i]);
+		} else if (atoi(argv[i]) > 0 && nsizes < 32) {
+			sizes[nsizes++] = atoi(argv[i]);
+		} else {
+			fprintf(stderr, "Usage: bench_shortname [-q lookups] [size ...]\n");
+			return -1;
+		}
+	}
+	if (nsizes == 0) {
+		sizes[nsizes++] = 1000;
+		sizes[nsizes++] = 10000;
+		sizes[nsizes++] = 100000;
+	}
+
+	unsigned long long state = 47;
+	bool ok = true;
+	char (*query)[40] = malloc(lookups * sizeof(*query));
+	int *want = malloc(lookups * sizeof(int));
+	printf("names,length,lookups,strcmp_ns,packed_ns,mismatches\n");
+	for (int s = 0; s < nsizes; s++) {
+		int n = sizes[s];
+		char (*names)[40] = malloc(n * sizeof(*names));
+		shortname *keys = malloc(n * sizeof(shortname));
+		for (int longname = 0; longname < 2; longname++) {
+			// Shuffled, so the names found are spread over the array.
+			for (int i = 0; i < n; i++) {
+				code(i, longname, names[i]);
+			}
+			for (int i = n - 1; i > 0; i--) {
+				int j = gen_rand(&state) % i;
+				char t[40];
+				strcpy(t, names[i]);
+				strcpy(names[i], names[j]);
+				strcpy(names[j], t);
+			}
+			for (int i = 0; i < n; i++) {
+				shortname_pack(names[i], &keys[i]);
+			}
+			for (int i = 0; i < lookups; i++) {
+				strcpy(query[i], names[gen_rand(&state) % n]);
+				if (i % 10 == 9) {
+					query[i][strlen(query[i]) - 1] = 'a';
+				}
+			}
+
+			long long t0 = timer_now();
+			for (int i = 0; i < lookups; i++) {
+				want[i] = scan_strcmp(names, n, query[i]);
+			}
+			double ns1 = (double)(timer_now() - t0) / lookups;
+
+			int mismatches = 0;
+			t0 = timer_now();
+			for (int i = 0; i < lookups; i++) {
+				mismatches += scan_packed(keys, names, n, query[i]) != want[i];
+			}
+			double ns2 = (double)(timer_now() - t0) / lookups;
+
+			printf("%d,%d,%d,%.1f,%.1f,%d\n", n, (int)strlen(names[0]),
+				lookups, ns1, ns2, mismatches);
+			fflush(stdout);
+			ok = ok && mismatches == 0;
+		}
+		free(keys);
+		free(names);
+	}
+	free(want);
+	free(query);
+	return ok ? 0 : 1;
+}
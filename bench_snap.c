@@ -0,0 +1,199 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "snap.h"
+#include "gen.h"
+#include "timer.h"
+//gcc -std=c99 -Wall -O2 -pthread -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o bench_snap bench_snap.c snap.c gen.c stats.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Reachability queries on a snap while a writer keeps changing it.
+ *
+ * Usage: bench_snap [-n nodes] [-r readers] [-t transactions] [-k ops]
+ *
+ * Builds a random graph (random generator, two edges per node), then
+ * runs the reader threads, which answer random reachability queries on
+ * whatever version is current, against one writer committing
+ * transactions of k edge moves (delete one edge, insert another from
+ * the same node). Every 1024th query a reader also checks that the degree
+ * sum of its pinned version equals its edge count, which a torn version
+ * would break. The readers run once alone and once with the writer, and
+ * the query rates of both runs are printed with the commit rate. At the
+ * end the final version is compared with a graph4.c graph that had the
+ * same changes applied.
+ */
+
+struct reader_arg {
+	snap *s;
+	int n;
+	unsigned long long seed;
+	bool *stop;
+	long queries;
+	long checks;
+	long torn;
+};
+
+static void *reader_main(void *arg)
+{
+	struct reader_arg *a = arg;
+	snap_reader *r = snap_reader_create(a->s);
+	unsigned long long state = a->seed | 1;
+
+	while (!__atomic_load_n(a->stop, __ATOMIC_RELAXED)) {
+		const snap_version *v = snap_read_begin(r);
+		snap_reach(r, v, gen_rand(&state) % a->n, gen_rand(&state) % a->n);
+		if (++a->queries % 1024 == 0) {
+			long sum = 0;
+			for (int u = 0; u < snap_id_bound(v); u++) {
+				int count;
+				snap_neighbours(v, u, &count);
+				sum += count;
+			}
+			a->checks++;
+			a->torn += sum != snap_edgecount(v);
+		}
+		snap_read_end(r);
+	}
+	snap_reader_kill(r);
+	return NULL;
+}
+
+/*
+ * Run the readers for half a second, or while the writer commits txns
+ * transactions if txns > 0. Returns the total queries per second.
+ */
+static double run(snap *s, graph *g, node **nodes, int n, int readers,
+	int txns, int ops, long *torn, double *commit_rate)
+{
+	pthread_t *threads = malloc(readers * sizeof(pthread_t));
+	struct reader_arg *args = calloc(readers, sizeof(struct reader_arg));
+	bool stop = false;
+	unsigned long long state = 99;
+
+	for (int k = 0; k < readers; k++) {
+		args[k] = (struct reader_arg){ s, n, 1000 + k, &stop, 0, 0, 0 };
+		pthread_create(&threads[k], NULL, reader_main, &args[k]);
+	}
+	long long t0 = timer_now();
+	if (txns > 0) {
+		for (int t = 0; t < txns; t++) {
+			snap_begin(s);
+			for (int k = 0; k < ops; k++) {
+				int u = gen_rand(&state) % n;
+				int count;
+				node *const *nb = graph_neighbours_span(g, nodes[u], &count);
+				if (count == 0) {
+					continue;
+				}
+				node *from = nb[gen_rand(&state) % count];
+				node *to = nodes[gen_rand(&state) % n];
+				int uid = graph_node_id(nodes[u]);
+				if (snap_insert_edge(s, uid, graph_node_id(to))) {
+					snap_delete_edge(s, uid, graph_node_id(from));
+					graph_delete_edge(g, nodes[u], from);
+					graph_insert_edge(g, nodes[u], to);
+				}
+			}
+			snap_commit(s);
+		}
+		*commit_rate = txns / ((timer_now() - t0) / 1e9);
+	} else {
+		struct timespec ts = { 0, 500 * 1000000L };
+		nanosleep(&ts, NULL);
+	}
+	double secs = (timer_now() - t0) / 1e9;
+	__atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+
+	long queries = 0;
+	for (int k = 0; k < readers; k++) {
+		pthread_join(threads[k], NULL);
+		queries += args[k].queries;
+		*torn += args[k].torn;
+	}
+	free(args);
+	free(threads);
+	return queries / secs;
+}
+
+int main(int argc, char const *argv[])
+{
+	int n = 100000;
+	int readers = 4;
+	int txns = 2000;
+	int ops = 16;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!strcmp(argv[i], "-n")) {
+			n = atoi(argv[i + 1]);
+		} else if (!strcmp(argv[i], "-r")) {
+			readers = atoi(argv[i + 1]);
+		} else if (!strcmp(argv[i], "-t")) {
+			txns = atoi(argv[i + 1]);
+		} else if (!strcmp(argv[i], "-k")) {
+			ops = atoi(argv[i + 1]);
+		} else {
+			break;
+		}
+	}
+	if (n <= 0 || readers <= 0 || readers >= SNAP_READERS || argc % 2 == 0) {
+		fprintf(stderr, "Usage: bench_snap [-n nodes] [-r readers] [-t transactions] [-k ops]\n");
+		return -1;
+	}
+
+	edgelist *e = gen_random(n, 2 * n, 7);
+	node **nodes = malloc(n * sizeof(node *));
+	graph *g = gen_graph(e, false, nodes);
+	snap *s = snap_create(g);
+
+	long torn = 0;
+	double commits = 0;
+	double alone = run(s, g, nodes, n, readers, 0, ops, &torn, &commits);
+	double during = run(s, g, nodes, n, readers, txns, ops, &torn, &commits);
+
+	// The final version must match the graph.
+	long mismatches = 0;
+	snap_reader *r = snap_reader_create(s);
+	const snap_version *v = snap_read_begin(r);
+	for (int i = 0; i < n; i++) {
+		int count;
+		const int *dest = snap_neighbours(v, graph_node_id(nodes[i]), &count);
+		int gcount;
+		node *const *nb = graph_neighbours_span(g, nodes[i], &gcount);
+		mismatches += count != gcount;
+		for (int k = 0; k < gcount && count == gcount; k++) {
+			int id = graph_node_id(nb[k]);
+			int j = 0;
+			while (j < count && dest[j] != id) {
+				j++;
+			}
+			mismatches += j == count;
+		}
+	}
+
+	printf("nodes %d\n", n);
+	printf("edges %ld\n", snap_edgecount(v));
+	printf("readers %d\n", readers);
+	printf("queries_per_s_alone %.0f\n", alone);
+	printf("queries_per_s_during_updates %.0f\n", during);
+	printf("commits_per_s %.0f\n", commits);
+	printf("ops_per_commit %d\n", ops);
+	printf("final_version %ld\n", snap_version_number(v));
+	printf("retired_left %ld\n", snap_retired(s));
+	printf("torn_versions %ld\n", torn);
+	printf("mismatches %ld\n", mismatches);
+	snap_read_end(r);
+	snap_reader_kill(r);
+
+	snap_kill(s);
+	graph_kill(g);
+	free(nodes);
+	edgelist_kill(e);
+	return torn == 0 && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#ifndef __CGRAPH_H
+#define __CGRAPH_H
+
+#include "graph.h"
+
+/*
+ * Compact, read-only copy of a graph. Nodes are renumbered densely from
+ * 0 to nodecount - 1 and both the outgoing and the incoming edges are
+ * stored as offset/target arrays (CSR), so traversals only touch a few
+ * contiguous arrays instead of chasing dlist cells.
+ *
+ * The out-neighbours of node v are out[out_off[v]] .. out[out_off[v+1]-1]
+ * and the in-neighbours are found the same way in in_off/in. Both lists
+ * are sorted by node id.
+ *
+ * The dense ids can follow the node list of the graph or one of the
+ * CGRAPH_ORDER_* orders, which put nodes that are close in the graph
+ * close in memory as well.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct cgraph {
+	int nodecount;
+	int edgecount;
+	int *out_off;
+	int *out;
+	int *in_off;
+	int *in;
+	node **nodes;	// Dense id -> node in the source graph.
+	int *dense;	// graph_node_id() -> dense id, or -1.
+	int idbound;
+} cgraph;
+
+#define CGRAPH_ORDER_LIST 0	// Order of the node list of the graph.
+#define CGRAPH_ORDER_BFS 1	// Breadth-first order.
+#define CGRAPH_ORDER_RCM 2	// Reverse Cuthill-McKee.
+#define CGRAPH_ORDER_DEGREE 3	// Highest degree first.
+
+cgraph *cgraph_freeze(const graph *g);
+cgraph *cgraph_freeze_ordered(const graph *g, int order);
+cgraph *cgraph_from_edges(int n, int m, const int *src, const int *dest);
+int *cgraph_order(const cgraph *c, int order);
+cgraph *cgraph_permute(const cgraph *c, const int *perm);
+int cgraph_order_parse(const char *name);
+int cgraph_id(const cgraph *c, const node *n);
+void cgraph_kill(cgraph *c);
+
+#endif
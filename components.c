@@ -0,0 +1,300 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "cgraph.h"
+#include "components.h"
+
+/*
+ * Implementation of whole-graph connected components.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+#define PHASE_INIT 0	// Make every node its own root.
+#define PHASE_SAMPLE 1	// Link out-edge number round of every node.
+#define PHASE_FINISH 2	// Link the other edges of nodes outside big.
+#define PHASE_COMPRESS 3	// Point every node straight at its root.
+
+/* The share of the nodes one thread works on in one phase. */
+struct share {
+	const cgraph *c;
+	int *comp;
+	int lo;
+	int hi;
+	int phase;
+	int round;
+	int big;	// Root of the big component in PHASE_FINISH.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static int load(const int *comp, int v)
+{
+	return __atomic_load_n(&comp[v], __ATOMIC_RELAXED);
+}
+
+/*
+ * Put u and v in the same tree. Roots are only ever hooked under a
+ * smaller node, with a compare-and-swap that fails if another thread
+ * hooked the same root first, in which case the walk goes on from
+ * where that left it.
+ */
+static void link(int *comp, int u, int v)
+{
+	int p1 = load(comp, u);
+	int p2 = load(comp, v);
+	while (p1 != p2) {
+		int high = p1 > p2 ? p1 : p2;
+		int low = p1 + p2 - high;
+		int phigh = load(comp, high);
+		if (phigh == low) {
+			break;
+		}
+		if (phigh == high && __atomic_compare_exchange_n(&comp[high], &phigh,
+			low, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			break;
+		}
+		p1 = load(comp, load(comp, high));
+		p2 = load(comp, low);
+	}
+}
+
+static void compress(int *comp, int v)
+{
+	int p = load(comp, v);
+	while (p != load(comp, p)) {
+		p = load(comp, p);
+		__atomic_store_n(&comp[v], p, __ATOMIC_RELAXED);
+	}
+}
+
+static void *run_share(void *arg)
+{
+	struct share *s = arg;
+	const cgraph *c = s->c;
+	int *comp = s->comp;
+
+	for (int v = s->lo; v < s->hi; v++) {
+		if (s->phase == PHASE_INIT) {
+			comp[v] = v;
+		} else if (s->phase == PHASE_SAMPLE) {
+			if (c->out_off[v] + s->round < c->out_off[v + 1]) {
+				link(comp, v, c->out[c->out_off[v] + s->round]);
+			}
+		} else if (s->phase == PHASE_FINISH) {
+			if (load(comp, v) == s->big) {
+				continue;
+			}
+			for (int i = c->out_off[v] + COMPONENTS_ROUNDS; i < c->out_off[v + 1]; i++) {
+				link(comp, v, c->out[i]);
+			}
+			// Out-edges of nodes in the big component are skipped, so the
+			// nodes they lead to link themselves through their in-edges.
+			for (int i = c->in_off[v]; i < c->in_off[v + 1]; i++) {
+				link(comp, v, c->in[i]);
+			}
+		} else {
+			compress(comp, v);
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Run one phase over all nodes, split evenly over nthreads threads.
+ */
+static void run_phase(const cgraph *c, int *comp, int nthreads, int phase,
+	int round, int big)
+{
+	struct share *s = malloc(nthreads * sizeof(struct share));
+	pthread_t *threads = malloc(nthreads * sizeof(pthread_t));
+	for (int k = 0; k < nthreads; k++) {
+		s[k].c = c;
+		s[k].comp = comp;
+		s[k].lo = (long long)c->nodecount * k / nthreads;
+		s[k].hi = (long long)c->nodecount * (k + 1) / nthreads;
+		s[k].phase = phase;
+		s[k].round = round;
+		s[k].big = big;
+	}
+	if (nthreads == 1) {
+		run_share(&s[0]);
+	} else {
+		for (int k = 0; k < nthreads; k++) {
+			pthread_create(&threads[k], NULL, run_share, &s[k]);
+		}
+		for (int k = 0; k < nthreads; k++) {
+			pthread_join(threads[k], NULL);
+		}
+	}
+	free(threads);
+	free(s);
+}
+
+static int by_int(const void *a, const void *b)
+{
+	const int x = *(const int *)a;
+	const int y = *(const int *)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Return the root that most of COMPONENTS_SAMPLES random nodes have.
+ * comp must be compressed. Any root gives the right components, a bad
+ * pick only means fewer edges are skipped.
+ */
+static int most_frequent(const int *comp, int n)
+{
+	int *seen = malloc(COMPONENTS_SAMPLES * sizeof(int));
+	unsigned long long x = 0x9e3779b97f4a7c15ULL;
+	for (int k = 0; k < COMPONENTS_SAMPLES; k++) {
+		// xorshift64
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		seen[k] = comp[x % n];
+	}
+	qsort(seen, COMPONENTS_SAMPLES, sizeof(int), by_int);
+	int best = seen[0];
+	int bestrun = 0;
+	for (int k = 0, run = 0; k < COMPONENTS_SAMPLES; k++) {
+		run = k > 0 && seen[k] == seen[k - 1] ? run + 1 : 1;
+		if (run > bestrun) {
+			best = seen[k];
+			bestrun = run;
+		}
+	}
+	free(seen);
+	return best;
+}
+
+/*
+ * Turn the roots in comp into dense labels numbered in order of the
+ * smallest node of each component, and count the sizes.
+ */
+static components *relabel(const int *comp, int n)
+{
+	components *cc = malloc(sizeof(components));
+	int *dense = malloc((n + 1) * sizeof(int));
+	cc->label = malloc((n + 1) * sizeof(int));
+	cc->count = 0;
+	for (int v = 0; v < n; v++) {
+		dense[v] = -1;
+	}
+	for (int v = 0; v < n; v++) {
+		int r = comp[v];
+		if (dense[r] < 0) {
+			dense[r] = cc->count++;
+		}
+		cc->label[v] = dense[r];
+	}
+	cc->size = calloc(cc->count + 1, sizeof(int));
+	for (int v = 0; v < n; v++) {
+		cc->size[cc->label[v]]++;
+	}
+	free(dense);
+	return cc;
+}
+
+static int uf_find(int *parent, int x)
+{
+	while (parent[x] != x) {
+		// Path halving.
+		parent[x] = parent[parent[x]];
+		x = parent[x];
+	}
+	return x;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * components_union_find() - Find the components with union-find.
+ * @c: Compact graph.
+ *
+ * Union by size with path halving, one pass over the out-edges.
+ *
+ * Returns: A pointer to the new components.
+ */
+components *components_union_find(const cgraph *c)
+{
+	int n = c->nodecount;
+	int *parent = malloc((n + 1) * sizeof(int));
+	int *weight = malloc((n + 1) * sizeof(int));
+	for (int v = 0; v < n; v++) {
+		parent[v] = v;
+		weight[v] = 1;
+	}
+	for (int v = 0; v < n; v++) {
+		for (int i = c->out_off[v]; i < c->out_off[v + 1]; i++) {
+			int a = uf_find(parent, v);
+			int b = uf_find(parent, c->out[i]);
+			if (a == b) {
+				continue;
+			}
+			if (weight[a] < weight[b]) {
+				int t = a;
+				a = b;
+				b = t;
+			}
+			parent[b] = a;
+			weight[a] += weight[b];
+		}
+	}
+	for (int v = 0; v < n; v++) {
+		parent[v] = uf_find(parent, v);
+	}
+	components *cc = relabel(parent, n);
+	free(weight);
+	free(parent);
+	return cc;
+}
+
+/**
+ * components_afforest() - Find the components on several threads.
+ * @c: Compact graph.
+ * @nthreads: Number of threads to use, at least 1.
+ *
+ * Returns: A pointer to the new components.
+ */
+components *components_afforest(const cgraph *c, int nthreads)
+{
+	int n = c->nodecount;
+	int *comp = malloc((n + 1) * sizeof(int));
+	if (nthreads < 1) {
+		nthreads = 1;
+	}
+	if (nthreads > n) {
+		nthreads = n > 0 ? n : 1;
+	}
+
+	run_phase(c, comp, nthreads, PHASE_INIT, 0, 0);
+	for (int r = 0; r < COMPONENTS_ROUNDS; r++) {
+		run_phase(c, comp, nthreads, PHASE_SAMPLE, r, 0);
+		run_phase(c, comp, nthreads, PHASE_COMPRESS, 0, 0);
+	}
+	int big = n > 0 ? most_frequent(comp, n) : 0;
+	run_phase(c, comp, nthreads, PHASE_FINISH, 0, big);
+	run_phase(c, comp, nthreads, PHASE_COMPRESS, 0, 0);
+
+	components *cc = relabel(comp, n);
+	free(comp);
+	return cc;
+}
+
+/**
+ * components_kill() - Destroy a set of components.
+ * @cc: Components to destroy.
+ *
+ * Returns: Nothing.
+ */
+void components_kill(components *cc)
+{
+	free(cc->label);
+	free(cc->size);
+	free(cc);
+}
@@ -0,0 +1,43 @@
+#ifndef __COMPONENTS_H
+#define __COMPONENTS_H
+
+#include "cgraph.h"
+
+/*
+ * Connected components of a whole compact graph. Edges are treated as
+ * undirected, i.e. these are the weakly connected components, the same
+ * ones dynconn.h keeps up to date under changes.
+ *
+ * components_union_find() is the sequential baseline: one union-find
+ * pass over all edges. components_afforest() runs the Afforest
+ * algorithm on a number of threads. Every node starts as its own tree
+ * in a shared parent array, and edges are linked with compare-and-swap
+ * hooks from the larger root to the smaller one, so threads never take
+ * a lock. First only the first COMPONENTS_ROUNDS out-edges of every node
+ * are linked, which in most graphs already puts nearly all nodes in one
+ * big component. That component is found by sampling, and the remaining
+ * edges are then only linked for nodes outside it, skipping most of the
+ * edges of the graph.
+ *
+ * Both return the same result: a dense label per node, numbered from 0
+ * in order of the smallest node id in each component, and the size of
+ * every component.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define COMPONENTS_ROUNDS 2	// Out-edges per node linked before sampling.
+#define COMPONENTS_SAMPLES 1024	// Nodes sampled to find the big component.
+
+typedef struct components {
+	int count;	// Number of components.
+	int *label;	// Dense id -> component, 0 .. count - 1.
+	int *size;	// Component -> number of nodes.
+} components;
+
+components *components_union_find(const cgraph *c);
+components *components_afforest(const cgraph *c, int nthreads);
+void components_kill(components *cc);
+
+#endif
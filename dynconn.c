@@ -0,0 +1,317 @@
+#include <stdlib.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "path.h"
+#include "dynconn.h"
+
+/*
+ * Implementation of the dynamic connectivity layer.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+struct dynconn {
+	int *parent;	// Union-find forest indexed by graph_node_id().
+	int *rank;
+	int size;
+	int oneway;	// Number of edges without a reverse edge.
+	bool stale;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * Make room for every node id currently handed out by the graph. New
+ * ids start as singleton components.
+ */
+static void ensure_size(dynconn *dc, const graph *g)
+{
+	int bound = graph_id_bound(g);
+	if (bound <= dc->size) {
+		return;
+	}
+	int cap = dc->size ? dc->size : 16;
+	while (cap < bound) {
+		cap *= 2;
+	}
+	dc->parent = realloc(dc->parent, cap * sizeof(int));
+	dc->rank = realloc(dc->rank, cap * sizeof(int));
+	for (int i = dc->size; i < cap; i++) {
+		dc->parent[i] = i;
+		dc->rank[i] = 0;
+	}
+	dc->size = cap;
+}
+
+static int uf_find(dynconn *dc, int x)
+{
+	while (dc->parent[x] != x) {
+		// Path halving.
+		dc->parent[x] = dc->parent[dc->parent[x]];
+		x = dc->parent[x];
+	}
+	return x;
+}
+
+static void uf_union(dynconn *dc, int a, int b)
+{
+	a = uf_find(dc, a);
+	b = uf_find(dc, b);
+	if (a == b) {
+		return;
+	}
+	if (dc->rank[a] < dc->rank[b]) {
+		int t = a;
+		a = b;
+		b = t;
+	}
+	dc->parent[b] = a;
+	if (dc->rank[a] == dc->rank[b]) {
+		dc->rank[a]++;
+	}
+}
+
+static bool has_edge(const graph *g, const node *n1, const node *n2)
+{
+	GRAPH_FOR_EACH_NEIGHBOUR(g, n1, nb) {
+		if (nodes_are_equal(nb, n2)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Recompute the components and the one-way edge count from scratch.
+ *
+ * The edges into every node are gathered by id first. Then the
+ * out-neighbours of each node v are marked with v, so an edge u -> v has
+ * its reverse exactly when u carries v's mark, one array lookup per edge.
+ */
+static void rebuild(dynconn *dc, const graph *g)
+{
+	ensure_size(dc, g);
+	for (int i = 0; i < dc->size; i++) {
+		dc->parent[i] = i;
+		dc->rank[i] = 0;
+	}
+	dc->oneway = 0;
+
+	int bound = graph_id_bound(g);
+	int *in_off = calloc(bound + 1, sizeof(int));
+	int *in = malloc((graph_edgecount(g) + 1) * sizeof(int));
+	int *mark = malloc((bound + 1) * sizeof(int));
+
+	dlist *nodes = graph_nodes(g);
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *n1 = dlist_inspect(nodes, pos);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n1, n2) {
+			uf_union(dc, graph_node_id(n1), graph_node_id(n2));
+			in_off[graph_node_id(n2) + 1]++;
+		}
+	}
+	for (int i = 0; i < bound; i++) {
+		in_off[i + 1] += in_off[i];
+		mark[i] = -1;
+	}
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *n1 = dlist_inspect(nodes, pos);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n1, n2) {
+			// Moves each offset on to the next node's, put back below.
+			in[in_off[graph_node_id(n2)]++] = graph_node_id(n1);
+		}
+	}
+	for (int i = bound; i > 0; i--) {
+		in_off[i] = in_off[i - 1];
+	}
+	in_off[0] = 0;
+
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *n = dlist_inspect(nodes, pos);
+		int v = graph_node_id(n);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n, nb) {
+			mark[graph_node_id(nb)] = v;
+		}
+		for (int i = in_off[v]; i < in_off[v + 1]; i++) {
+			if (mark[in[i]] != v) {
+				dc->oneway++;
+			}
+		}
+	}
+	free(mark);
+	free(in);
+	free(in_off);
+	dc->stale = false;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * dynconn_build() - Compute the components of a graph.
+ * @g: Graph to track.
+ *
+ * Returns: A pointer to the new connectivity structure.
+ */
+dynconn *dynconn_build(const graph *g)
+{
+	dynconn *dc = malloc(sizeof(dynconn));
+	dc->parent = NULL;
+	dc->rank = NULL;
+	dc->size = 0;
+	rebuild(dc, g);
+	return dc;
+}
+
+/**
+ * dynconn_insert_node() - Insert a node and track it.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph to manipulate.
+ * @s: Node name.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynconn_insert_node(dynconn *dc, graph *g, const char *s)
+{
+	g = graph_insert_node(g, s);
+	ensure_size(dc, g);
+	return g;
+}
+
+/**
+ * dynconn_delete_node() - Remove a node and all its edges.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph to manipulate.
+ * @n: Node to remove from the graph.
+ *
+ * The components are recomputed on the next query.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynconn_delete_node(dynconn *dc, graph *g, node *n)
+{
+	dc->stale = true;
+	return graph_delete_node(g, n);
+}
+
+/**
+ * dynconn_insert_edge() - Insert an edge and merge the components.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynconn_insert_edge(dynconn *dc, graph *g, node *n1, node *n2)
+{
+	int before = graph_edgecount(g);
+	g = graph_insert_edge(g, n1, n2);
+	if (graph_edgecount(g) == before || dc->stale) {
+		// Already present, or everything is recomputed anyway.
+		return g;
+	}
+	ensure_size(dc, g);
+	uf_union(dc, graph_node_id(n1), graph_node_id(n2));
+	if (n1 == n2) {
+		// A self-loop is its own reverse edge.
+		return g;
+	}
+	if (has_edge(g, n2, n1)) {
+		dc->oneway--;
+	} else {
+		dc->oneway++;
+	}
+	return g;
+}
+
+/**
+ * dynconn_delete_edge() - Remove an edge and update the components.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * If the reverse edge is still in the graph the components are
+ * unchanged. Otherwise they are recomputed on the next query.
+ *
+ * Returns: The modified graph.
+ */
+graph *dynconn_delete_edge(dynconn *dc, graph *g, node *n1, node *n2)
+{
+	int before = graph_edgecount(g);
+	g = graph_delete_edge(g, n1, n2);
+	if (graph_edgecount(g) == before || dc->stale || n1 == n2) {
+		return g;
+	}
+	if (has_edge(g, n2, n1)) {
+		dc->oneway++;
+	} else {
+		dc->stale = true;
+	}
+	return g;
+}
+
+/**
+ * dynconn_connected() - Check if two nodes are in the same component.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph the nodes belong to.
+ * @n1: First node.
+ * @n2: Second node.
+ *
+ * Returns: True if the nodes are connected when edge directions are
+ * ignored, otherwise false.
+ */
+bool dynconn_connected(dynconn *dc, const graph *g, const node *n1, const node *n2)
+{
+	if (dc->stale) {
+		rebuild(dc, g);
+	}
+	ensure_size(dc, g);
+	return uf_find(dc, graph_node_id(n1)) == uf_find(dc, graph_node_id(n2));
+}
+
+/**
+ * dynconn_find_path() - Check if there is a path between two nodes.
+ * @dc: Connectivity structure for the graph.
+ * @g: Graph to search.
+ * @src: Node to start from.
+ * @dest: Node to look for.
+ *
+ * Nodes in different components are rejected at once. If every edge has
+ * a reverse edge the component test is the full answer; otherwise the
+ * query falls back to find_path().
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool dynconn_find_path(dynconn *dc, graph *g, node *src, node *dest)
+{
+	if (!dynconn_connected(dc, g, src, dest)) {
+		return false;
+	}
+	if (dc->oneway == 0) {
+		return true;
+	}
+	return find_path(g, src, dest);
+}
+
+/**
+ * dynconn_kill() - Destroy a connectivity structure.
+ * @dc: Structure to destroy.
+ *
+ * The graph is not affected.
+ *
+ * Returns: Nothing.
+ */
+void dynconn_kill(dynconn *dc)
+{
+	free(dc->parent);
+	free(dc->rank);
+	free(dc);
+}
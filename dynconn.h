@@ -0,0 +1,41 @@
+#ifndef __DYNCONN_H
+#define __DYNCONN_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * Connected components of a graph kept up to date while the graph
+ * changes. Edges are treated as undirected, i.e. the layer tracks weakly
+ * connected components.
+ *
+ * Changes must go through the dynconn_* functions below. Edge inserts are
+ * folded into a union-find structure in near constant time. Union-find
+ * cannot split a component, so a delete that may disconnect two nodes
+ * only marks the structure stale; it is rebuilt from the graph on the
+ * next query, once for any number of deletes in between. Deleting one
+ * direction of an edge whose reverse edge remains never splits anything
+ * and is handled without a rebuild.
+ *
+ * Two nodes in different components can never reach each other. As long
+ * as every edge has its reverse edge in the graph (the usual case for a
+ * route map) the components are also exactly the reachability classes,
+ * and dynconn_find_path() answers without a search.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct dynconn dynconn;
+
+dynconn *dynconn_build(const graph *g);
+graph *dynconn_insert_node(dynconn *dc, graph *g, const char *s);
+graph *dynconn_delete_node(dynconn *dc, graph *g, node *n);
+graph *dynconn_insert_edge(dynconn *dc, graph *g, node *n1, node *n2);
+graph *dynconn_delete_edge(dynconn *dc, graph *g, node *n1, node *n2);
+bool dynconn_connected(dynconn *dc, const graph *g, const node *n1, const node *n2);
+bool dynconn_find_path(dynconn *dc, graph *g, node *src, node *dest);
+void dynconn_kill(dynconn *dc);
+
+#endif
@@ -0,0 +1,221 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "export.h"
+
+/*
+ * Implementation of the graph dumps.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define WRITER_SIZE 65536
+
+// ===========INTERNAL DATA TYPES============
+
+/* Buffered writer, flushed with one fwrite() per WRITER_SIZE bytes. */
+struct writer {
+	FILE *f;
+	size_t len;
+	bool failed;
+	char buf[WRITER_SIZE];
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static void w_flush(struct writer *w)
+{
+	if (w->len > 0 && fwrite(w->buf, 1, w->len, w->f) != w->len) {
+		w->failed = true;
+	}
+	w->len = 0;
+}
+
+static void w_char(struct writer *w, char c)
+{
+	if (w->len == WRITER_SIZE) {
+		w_flush(w);
+	}
+	w->buf[w->len++] = c;
+}
+
+static void w_str(struct writer *w, const char *s)
+{
+	size_t n = strlen(s);
+	if (w->len + n > WRITER_SIZE) {
+		w_flush(w);
+		if (n > WRITER_SIZE) {
+			if (fwrite(s, 1, n, w->f) != n) {
+				w->failed = true;
+			}
+			return;
+		}
+	}
+	memcpy(w->buf + w->len, s, n);
+	w->len += n;
+}
+
+static void w_int(struct writer *w, long long v)
+{
+	char tmp[24];
+	int n = 0;
+	unsigned long long u = v < 0 ? -(unsigned long long)v : (unsigned long long)v;
+	do {
+		tmp[n++] = '0' + u % 10;
+		u /= 10;
+	} while (u > 0);
+	if (v < 0) {
+		w_char(w, '-');
+	}
+	while (n > 0) {
+		w_char(w, tmp[--n]);
+	}
+}
+
+/* Write a name as a DOT string, in quotes. */
+static void w_quoted(struct writer *w, const char *s)
+{
+	w_char(w, '"');
+	for (; *s; s++) {
+		if (*s == '"' || *s == '\\') {
+			w_char(w, '\\');
+		}
+		w_char(w, *s);
+	}
+	w_char(w, '"');
+}
+
+static void dump_adj(struct writer *w, const graph *g)
+{
+	dlist *nodes = graph_nodes(g);
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *n = dlist_inspect(nodes, pos);
+		w_str(w, graph_node_name(n));
+		w_char(w, ':');
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n, nb) {
+			w_char(w, ' ');
+			w_str(w, graph_node_name(nb));
+		}
+		w_char(w, '\n');
+	}
+}
+
+static void dump_mm(struct writer *w, const graph *g)
+{
+	dlist *nodes = graph_nodes(g);
+	int *index = malloc((graph_id_bound(g) + 1) * sizeof(int));
+	int n = 0;
+
+	w_str(w, "%%MatrixMarket matrix coordinate pattern general\n");
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *v = dlist_inspect(nodes, pos);
+		index[graph_node_id(v)] = ++n;
+		w_str(w, "% ");
+		w_int(w, n);
+		w_char(w, ' ');
+		w_str(w, graph_node_name(v));
+		w_char(w, '\n');
+	}
+	w_int(w, n);
+	w_char(w, ' ');
+	w_int(w, n);
+	w_char(w, ' ');
+	w_int(w, graph_edgecount(g));
+	w_char(w, '\n');
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *v = dlist_inspect(nodes, pos);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, v, nb) {
+			w_int(w, index[graph_node_id(v)]);
+			w_char(w, ' ');
+			w_int(w, index[graph_node_id(nb)]);
+			w_char(w, '\n');
+		}
+	}
+	free(index);
+}
+
+static void dump_dot(struct writer *w, const graph *g)
+{
+	dlist *nodes = graph_nodes(g);
+	w_str(w, "digraph G {\n");
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *v = dlist_inspect(nodes, pos);
+		w_char(w, '\t');
+		w_quoted(w, graph_node_name(v));
+		w_str(w, ";\n");
+		GRAPH_FOR_EACH_NEIGHBOUR(g, v, nb) {
+			w_char(w, '\t');
+			w_quoted(w, graph_node_name(v));
+			w_str(w, " -> ");
+			w_quoted(w, graph_node_name(nb));
+			w_str(w, ";\n");
+		}
+	}
+	w_str(w, "}\n");
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * graph_export_parse() - Look up an export format by name.
+ * @name: "adj", "mm" or "dot".
+ *
+ * Returns: One of the GRAPH_EXPORT_* formats, or -1 for an unknown name.
+ */
+int graph_export_parse(const char *name)
+{
+	static const char *names[] = { "adj", "mm", "dot" };
+	for (int k = 0; k < 3; k++) {
+		if (!strcmp(name, names[k])) {
+			return k;
+		}
+	}
+	return -1;
+}
+
+/**
+ * graph_export() - Dump a graph to a stream.
+ * @g: Graph to dump.
+ * @out: Stream to write to.
+ * @format: One of the GRAPH_EXPORT_* formats.
+ *
+ * Returns: 0 on success, -1 if writing failed or the format is unknown.
+ */
+int graph_export(const graph *g, FILE *out, int format)
+{
+	struct writer *w = malloc(sizeof(struct writer));
+	w->f = out;
+	w->len = 0;
+	w->failed = false;
+
+	switch (format) {
+	case GRAPH_EXPORT_ADJ:
+		dump_adj(w, g);
+		break;
+	case GRAPH_EXPORT_MM:
+		dump_mm(w, g);
+		break;
+	case GRAPH_EXPORT_DOT:
+		dump_dot(w, g);
+		break;
+	default:
+		w->failed = true;
+		break;
+	}
+	w_flush(w);
+	if (fflush(out) != 0) {
+		w->failed = true;
+	}
+	int status = w->failed ? -1 : 0;
+	free(w);
+	return status;
+}
@@ -0,0 +1,33 @@
+#ifndef __EXPORT_H
+#define __EXPORT_H
+
+#include <stdio.h>
+
+#include "graph.h"
+
+/*
+ * Dumps of a whole graph for inspection, meant to work on graphs far
+ * too large for graph_print(). Output goes through one buffered writer
+ * and the only memory used besides it is one int per node id, so a dump
+ * is O(nodes + edges) in time and O(nodes) in memory.
+ *
+ * GRAPH_EXPORT_ADJ writes one line "NAME: NB1 NB2 ..." per node.
+ * GRAPH_EXPORT_MM writes a Matrix Market coordinate pattern matrix with
+ * a row per source and a column per destination, numbered from 1 in the
+ * order of the node list; the names are listed in comment lines first.
+ * GRAPH_EXPORT_DOT writes a Graphviz digraph.
+ *
+ * Works with any implementation of graph_ext.h.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define GRAPH_EXPORT_ADJ 0	// Adjacency list, one line per node.
+#define GRAPH_EXPORT_MM 1	// Matrix Market coordinate format.
+#define GRAPH_EXPORT_DOT 2	// Graphviz DOT.
+
+int graph_export_parse(const char *name);
+int graph_export(const graph *g, FILE *out, int format);
+
+#endif
@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "gen.h"
+
+/*
+ * Implementation of the synthetic graph generators.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static edgelist *edgelist_empty(int n, int cap)
+{
+	edgelist *e = malloc(sizeof(edgelist));
+	e->nodecount = n;
+	e->edgecount = 0;
+	e->src = malloc((cap + 1) * sizeof(int));
+	e->dest = malloc((cap + 1) * sizeof(int));
+	return e;
+}
+
+static void edgelist_add(edgelist *e, int u, int v)
+{
+	e->src[e->edgecount] = u;
+	e->dest[e->edgecount] = v;
+	e->edgecount++;
+}
+
+static int by_pair(const void *a, const void *b)
+{
+	const long long *x = a;
+	const long long *y = b;
+	return (*x > *y) - (*x < *y);
+}
+
+/*
+ * Remove duplicate edges and shuffle the rest, so that the insertion
+ * order does not follow the structure of the generator.
+ */
+static void finish(edgelist *e, unsigned long long *state)
+{
+	int m = e->edgecount;
+	long long *pairs = malloc((m + 1) * sizeof(long long));
+	for (int i = 0; i < m; i++) {
+		pairs[i] = (long long)e->src[i] * e->nodecount + e->dest[i];
+	}
+	qsort(pairs, m, sizeof(long long), by_pair);
+	int k = 0;
+	for (int i = 0; i < m; i++) {
+		if (i == 0 || pairs[i] != pairs[i - 1]) {
+			pairs[k++] = pairs[i];
+		}
+	}
+	for (int i = k - 1; i > 0; i--) {
+		int j = gen_rand(state) % (i + 1);
+		long long t = pairs[i];
+		pairs[i] = pairs[j];
+		pairs[j] = t;
+	}
+	for (int i = 0; i < k; i++) {
+		e->src[i] = pairs[i] / e->nodecount;
+		e->dest[i] = pairs[i] % e->nodecount;
+	}
+	e->edgecount = k;
+	free(pairs);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * gen_rand() - Draw a pseudo-random number (xorshift64).
+ * @state: Generator state, must not be zero.
+ *
+ * Returns: The next number in the sequence.
+ */
+unsigned long long gen_rand(unsigned long long *state)
+{
+	unsigned long long x = *state;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+	return x;
+}
+
+/**
+ * gen_random() - Generate a uniform random directed graph.
+ * @n: Number of nodes.
+ * @m: Number of edges to draw. Duplicates are removed afterwards.
+ * @seed: Random seed.
+ *
+ * Returns: A pointer to the new edge list.
+ */
+edgelist *gen_random(int n, int m, unsigned long long seed)
+{
+	unsigned long long state = seed | 1;
+	edgelist *e = edgelist_empty(n, m);
+	for (int i = 0; i < m; i++) {
+		edgelist_add(e, gen_rand(&state) % n, gen_rand(&state) % n);
+	}
+	finish(e, &state);
+	return e;
+}
+
+/**
+ * gen_hub() - Generate a power-law hub-and-spoke graph.
+ * @n: Number of nodes.
+ * @k: Number of routes each new node opens.
+ * @seed: Random seed.
+ *
+ * Preferential attachment: every new node connects to k earlier nodes,
+ * picked with probability proportional to their degree, so a few hubs
+ * end up with most of the routes. Every route is added in both
+ * directions.
+ *
+ * Returns: A pointer to the new edge list.
+ */
+edgelist *gen_hub(int n, int k, unsigned long long seed)
+{
+	unsigned long long state = seed | 1;
+	edgelist *e = edgelist_empty(n, 2 * n * k);
+	// Every endpoint ever used; drawing from it is drawing by degree.
+	int *ends = malloc((2 * n * k + 2) * sizeof(int));
+	int nends = 0;
+
+	ends[nends++] = 0;
+	for (int v = 1; v < n; v++) {
+		for (int i = 0; i < k; i++) {
+			int u = ends[gen_rand(&state) % nends];
+			edgelist_add(e, v, u);
+			edgelist_add(e, u, v);
+			ends[nends++] = u;
+		}
+		ends[nends++] = v;
+	}
+	free(ends);
+	finish(e, &state);
+	return e;
+}
+
+/**
+ * gen_grid() - Generate a square grid graph.
+ * @side: Number of nodes along each side.
+ * @seed: Random seed for the edge order.
+ *
+ * Each node is connected to its four neighbours in both directions.
+ *
+ * Returns: A pointer to the new edge list.
+ */
+edgelist *gen_grid(int side, unsigned long long seed)
+{
+	unsigned long long state = seed | 1;
+	edgelist *e = edgelist_empty(side * side, 4 * side * side);
+	for (int y = 0; y < side; y++) {
+		for (int x = 0; x < side; x++) {
+			int v = y * side + x;
+			if (x + 1 < side) {
+				edgelist_add(e, v, v + 1);
+				edgelist_add(e, v + 1, v);
+			}
+			if (y + 1 < side) {
+				edgelist_add(e, v, v + side);
+				edgelist_add(e, v + side, v);
+			}
+		}
+	}
+	finish(e, &state);
+	return e;
+}
+
+/**
+ * gen_by_name() - Generate a graph of roughly n nodes by generator name.
+ * @name: "random" (2n edges), "hub" (2 routes per node) or "grid".
+ * @n: Wanted number of nodes. A grid is rounded down to a square.
+ * @seed: Random seed.
+ *
+ * Returns: A pointer to the new edge list, or NULL for an unknown name.
+ */
+edgelist *gen_by_name(const char *name, int n, unsigned long long seed)
+{
+	if (!strcmp(name, "random")) {
+		return gen_random(n, 2 * n, seed);
+	}
+	if (!strcmp(name, "hub")) {
+		return gen_hub(n, 2, seed);
+	}
+	if (!strcmp(name, "grid")) {
+		int side = 1;
+		while ((side + 1) * (side + 1) <= n) {
+			side++;
+		}
+		return gen_grid(side, seed);
+	}
+	return NULL;
+}
+
+/**
+ * gen_graph() - Build a graph from an edge list.
+ * @e: Edge list to insert.
+ * @both: If true, every edge is also inserted in the other direction.
+ * @nodes: Array of e->nodecount entries, where node i is stored.
+ *
+ * Node i gets the name "N<i>".
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *gen_graph(const edgelist *e, bool both, node **nodes)
+{
+	char name[16];
+	graph *g = graph_empty(e->nodecount);
+	for (int i = 0; i < e->nodecount; i++) {
+		sprintf(name, "N%d", i);
+		g = graph_insert_node(g, name);
+		// graph_insert_node puts new nodes first in the node list.
+		nodes[i] = graph_choose_node(g);
+	}
+	for (int i = 0; i < e->edgecount; i++) {
+		g = graph_insert_edge(g, nodes[e->src[i]], nodes[e->dest[i]]);
+		if (both) {
+			g = graph_insert_edge(g, nodes[e->dest[i]], nodes[e->src[i]]);
+		}
+	}
+	return g;
+}
+
+/**
+ * edgelist_kill() - Destroy an edge list.
+ * @e: Edge list to destroy.
+ *
+ * Returns: Nothing.
+ */
+void edgelist_kill(edgelist *e)
+{
+	free(e->src);
+	free(e->dest);
+	free(e);
+}
@@ -0,0 +1,33 @@
+#ifndef __GEN_H
+#define __GEN_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * Synthetic graphs for the benchmarks. A generator returns a plain edge
+ * list over the node numbers 0 .. nodecount-1 without duplicate edges,
+ * in random order. Node i is meant to be inserted with the name "N<i>",
+ * which gen_graph() does.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct edgelist {
+	int nodecount;
+	int edgecount;
+	int *src;
+	int *dest;
+} edgelist;
+
+unsigned long long gen_rand(unsigned long long *state);
+edgelist *gen_random(int n, int m, unsigned long long seed);
+edgelist *gen_hub(int n, int k, unsigned long long seed);
+edgelist *gen_grid(int side, unsigned long long seed);
+edgelist *gen_by_name(const char *name, int n, unsigned long long seed);
+graph *gen_graph(const edgelist *e, bool both, node **nodes);
+void edgelist_kill(edgelist *e);
+
+#endif
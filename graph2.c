@@ -1,37 +1,235 @@
-
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "graph.h"
+#include "graph_ext.h"
+#include "stats.h"
+#include "log.h"
 
 /*
-* Implementation of a graph.
+* Implementation of a graph as a list of edges.
+*
+* All edges live in one array of (source id, destination id) pairs.
+* Inserting an edge appends to the array and deleting one only marks it
+* dead, so ingest never touches any per-node structure. The array is
+* sorted and compacted, and an offset index over it built, the first
+* time something needs to look at it by node (graph_neighbours(), the
+* duplicate check in graph_insert_edge(), graph_edgecount()). Scans
+* over all edges (graph_edges(), graph_delete_node()) walk the array
+* directly.
+*
+* graph_neighbours() turns the range of a node into a dlist that is
+* cached in the node until the edges change again.
 *
 * Authors: Niklas Hörnblad (c19nhd@cs.umu.se)
 *
 * Version information:
 *   2018-02-06: v1.0, first public version.
+*   2026-10-18: v2.0, sorted edge array with an index built on demand.
 */
 
 // ===========INTERNAL DATA TYPES============
 
 struct node {
-	char *name;
-	bool *seen;
+	char name[41];
+	int id;
+	node **adj;		// Cached neighbours, see refresh().
+	int degree;
+	int adjcap;
+	dlist *neighbours;	// Made from adj by graph_neighbours().
+	int version;		// Index version adj was built for.
 };
 
-struct graph {
-	dlist *nodes;
-	dlist *edges;
+struct edge {
+	int src;	// Source node id, or ~id if the edge has been deleted.
+	int dest;
 };
 
-struct edge {
-	node *n1;
-	node *n2;
+struct graph {
+	dlist *nodes;
+	node **byid;		// Node of each id, NULL for deleted nodes.
+	bool *seen;		// Seen flags, indexed by node id.
+	int idcap;
+	int nextid;
+	int nodecount;
+	int maxnodes;
+
+	struct edge *edges;
+	int edgecap;
+	int edgeslots;		// Used entries in edges, dead ones included.
+	int edgecount;		// Live edges (duplicates are dropped on indexing).
+	int dead;		// Deleted edges still in the array.
+	bool sorted;		// edges is sorted by (source, destination).
+	bool indexed;		// first is up to date with edges.
+	int *first;		// Start of the edges of each id, idcap + 1 entries.
+	int version;		// Bumped every time the index is rebuilt.
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+/*
+* Sort the live edges of g by (source, destination), drop dead and
+* duplicate edges and rebuild the offset index. Two counting sort passes,
+* so O(nodes + edges).
+*/
+static void build_index(graph *g)
+{
+	int n = g->nextid;
+	int *count = calloc(n + 1, sizeof(int));
+	struct edge *tmp = malloc((g->edgeslots + 1) * sizeof(struct edge));
+	int m = 0;
+
+	if (!g->sorted) {
+		// First pass: by destination, dropping dead edges.
+		for (int k = 0; k < g->edgeslots; k++) {
+			if (g->edges[k].src >= 0) {
+				count[g->edges[k].dest + 1]++;
+			}
+		}
+		for (int v = 0; v < n; v++) {
+			count[v + 1] += count[v];
+		}
+		for (int k = 0; k < g->edgeslots; k++) {
+			if (g->edges[k].src >= 0) {
+				tmp[count[g->edges[k].dest]++] = g->edges[k];
+				m++;
+			}
+		}
+		// Second pass, stable: by source.
+		memset(count, 0, (n + 1) * sizeof(int));
+		for (int k = 0; k < m; k++) {
+			count[tmp[k].src + 1]++;
+		}
+		for (int v = 0; v < n; v++) {
+			count[v + 1] += count[v];
+		}
+		for (int k = 0; k < m; k++) {
+			g->edges[count[tmp[k].src]++] = tmp[k];
+		}
+	} else {
+		for (int k = 0; k < g->edgeslots; k++) {
+			if (g->edges[k].src >= 0) {
+				g->edges[m++] = g->edges[k];
+			}
+		}
+	}
+	free(tmp);
+	free(count);
+
+	// Drop duplicates, they are adjacent now.
+	int out = 0;
+	for (int k = 0; k < m; k++) {
+		if (out > 0 && g->edges[out - 1].src == g->edges[k].src
+			&& g->edges[out - 1].dest == g->edges[k].dest) {
+			continue;
+		}
+		g->edges[out++] = g->edges[k];
+	}
+	g->edgeslots = out;
+	g->edgecount = out;
+	g->dead = 0;
+	g->sorted = true;
+
+	// The offset index.
+	for (int v = 0, k = 0; v <= n; v++) {
+		while (k < out && g->edges[k].src < v) {
+			k++;
+		}
+		g->first[v] = k;
+	}
+	g->indexed = true;
+	g->version++;
+	STATS_ADD(edges_scanned, out);
+}
+
+/*
+* Make sure the index of g is current. Dead edges do not make it stale,
+* they are skipped until the next rebuild. The graph does not change as
+* seen through graph.h, so this is allowed on a const graph.
+*/
+static void ensure_index(const graph *g)
+{
+	if (!g->indexed) {
+		build_index((graph *)g);
+	}
+}
+
+/*
+* Return the position of the edge src -> dest in the array of an
+* indexed graph, dead or alive, or -1 if there is none.
+*/
+static int find_edge(const graph *g, int src, int dest)
+{
+	int lo = g->first[src];
+	int hi = g->first[src + 1];
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		STATS_ADD(lookup_probes, 1);
+		if (g->edges[mid].dest < dest) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo < g->first[src + 1] && g->edges[lo].dest == dest) {
+		return lo;
+	}
+	return -1;
+}
+
+/*
+* Mark the edge at position k as deleted.
+*/
+static void kill_edge(graph *g, int k)
+{
+	node *n = g->byid[g->edges[k].src];
+	if (n != NULL) {
+		n->version = -1;
+	}
+	g->edges[k].src = ~g->edges[k].src;
+	g->edgecount--;
+	g->dead++;
+}
+
+/* Make room for count neighbours in the array of n. */
+static void reserve(node *n, int count)
+{
+	if (count > n->adjcap) {
+		n->adjcap = count > 2 * n->adjcap ? count : 2 * n->adjcap;
+		n->adj = realloc(n->adj, n->adjcap * sizeof(node *));
+		STATS_ADD(allocs, 1);
+	}
+}
+
+/*
+* Make sure the neighbour array of n is up to date with its range in the
+* edge array. A rebuilt array drops the dlist made from the old one,
+* graph_neighbours() makes it again when asked.
+*/
+static void refresh(const graph *g, node *n)
+{
+	ensure_index(g);
+	if (n->version == g->version) {
+		return;
+	}
+	int lo = g->first[n->id];
+	int hi = g->first[n->id + 1];
+	reserve(n, hi - lo);
+	n->degree = 0;
+	for (int k = lo; k < hi; k++) {
+		if (g->edges[k].src >= 0) {
+			n->adj[n->degree++] = g->byid[g->edges[k].dest];
+		}
+	}
+	STATS_ADD(edges_scanned, hi - lo);
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+		n->neighbours = NULL;
+	}
+	n->version = g->version;
+}
+
 /**
 * nodes_are_equal() - Check whether two nodes are equal.
 * @n1: Pointer to node 1.
@@ -42,7 +240,7 @@ struct edge {
 */
 bool nodes_are_equal(const node *n1,const node *n2)
 {
-	return n1->name == n2->name;
+	return n1 == n2;
 }
 
 /**
@@ -53,7 +251,23 @@ bool nodes_are_equal(const node *n1,const node *n2)
 */
 graph *graph_empty(int max_nodes)
 {
-	graph *g = calloc(max_nodes, sizeof(node));
+	graph *g = malloc(sizeof(graph));
+	g->nodes = dlist_empty(NULL);
+	g->idcap = 16;
+	g->byid = malloc(g->idcap * sizeof(node *));
+	g->seen = malloc(g->idcap * sizeof(bool));
+	g->first = calloc(g->idcap + 1, sizeof(int));
+	g->nextid = 0;
+	g->nodecount = 0;
+	g->maxnodes = max_nodes;
+	g->edgecap = 16;
+	g->edges = malloc(g->edgecap * sizeof(struct edge));
+	g->edgeslots = 0;
+	g->edgecount = 0;
+	g->dead = 0;
+	g->sorted = true;
+	g->indexed = true;
+	g->version = 0;
 	return g;
 }
 
@@ -76,7 +290,7 @@ bool graph_is_empty(const graph *g)
 */
 bool graph_has_edges(const graph *g)
 {
-	return dlist_is_empty(g->edges);
+	return g->edgecount > 0;
 }
 
 /**
@@ -91,26 +305,36 @@ bool graph_has_edges(const graph *g)
 */
 graph *graph_insert_node(graph *g, const char *s)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->nodes);
-
-	while (!dlist_is_end(g->nodes, pos)) {
-		// Inspect the table entry
-		node *entry = dlist_inspect(g->nodes, pos);
-		// Check if the entry key matches the search key.
-		if (*(entry->name) == *s) {
-			// If yes, return the corresponding value pointer.
-			printf("Warning: A node with that name already exists in the graph!");
-			return g;
-		}
-		// Continue with the next position.
-		pos = dlist_next(g->nodes, pos);
+	if (g->nodecount >= g->maxnodes) {
+		LOG_WARN("The graph is full, %s was not inserted", s);
+		return g;
+	}
+	if (graph_try_find_node(g, s) != NULL) {
+		LOG_INFO("A node with the name %s already exists in the graph", s);
+		return g;
+	}
+	if (g->nextid == g->idcap) {
+		g->idcap *= 2;
+		g->byid = realloc(g->byid, g->idcap * sizeof(node *));
+		g->seen = realloc(g->seen, g->idcap * sizeof(bool));
+		g->first = realloc(g->first, (g->idcap + 1) * sizeof(int));
 	}
 
 	node *n = malloc(sizeof(node));
-	*(n->name) = *s;
-	n->seen = false;
+	STATS_ADD(allocs, 1);
+	strncpy(n->name, s, sizeof(n->name) - 1);
+	n->name[sizeof(n->name) - 1] = '\0';
+	n->id = g->nextid++;
+	n->adj = NULL;
+	n->degree = 0;
+	n->adjcap = 0;
+	n->neighbours = NULL;
+	n->version = -1;
+	g->byid[n->id] = n;
+	g->seen[n->id] = false;
+	// The new node has no edges, so its range is empty.
+	g->first[n->id + 1] = g->first[n->id];
+	g->nodecount++;
 	dlist_insert(g->nodes, n, dlist_first(g->nodes));
 	return g;
 }
@@ -120,25 +344,17 @@ graph *graph_insert_node(graph *g, const char *s)
 * @g: Graph to manipulate.
 * @s: Node identifier, e.g. a char *.
 *
-* Returns: A pointer to the found node, or NULL.
+* Returns: A pointer to the found node. Exits the program if there is no
+* such node, use graph_try_find_node() to check first.
 */
 node *graph_find_node(const graph *g, const char *s)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->nodes);
-
-	while (!dlist_is_end(g->nodes, pos)) {
-		// Inspect the table entry
-		node *entry = dlist_inspect(g->nodes, pos);
-		// Check if the entry key matches the search key.
-		if (*(entry->name) == *s) {
-			// If yes, return the corresponding value pointer.
-			return entry;
-		}
-		// Continue with the next position.
-		pos = dlist_next(g->nodes, pos);
+	node *n = graph_try_find_node(g, s);
+	if (n == NULL) {
+		LOG_ERROR("There is no node with the name %s in the graph", s);
+		exit(EXIT_FAILURE);
 	}
+	return n;
 }
 
 /**
@@ -150,7 +366,7 @@ node *graph_find_node(const graph *g, const char *s)
 */
 bool graph_node_is_seen(const graph *g, const node *n)
 {
-	return n->seen;
+	return g->seen[n->id];
 }
 
 /**
@@ -163,7 +379,7 @@ bool graph_node_is_seen(const graph *g, const node *n)
 */
 graph *graph_node_set_seen(graph *g, node *n, bool seen)
 {
-	*(n->seen) = seen;
+	g->seen[n->id] = seen;
 	return g;
 }
 
@@ -175,19 +391,8 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen)
 */
 graph *graph_reset_seen(graph *g)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->nodes);
-
-	while (!dlist_is_end(g->nodes, pos)) {
-		// Inspect the table entry
-		node *entry = dlist_inspect(g->nodes, pos);
-
-		entry->seen = false;
-
-		// Continue with the next position.
-		pos = dlist_next(g->nodes, pos);
-	}
+	memset(g->seen, 0, g->nextid * sizeof(bool));
+	return g;
 }
 
 /**
@@ -196,16 +401,50 @@ graph *graph_reset_seen(graph *g)
 * @n1: Source node (pointer) for the edge.
 * @n2: Destination node (pointer) for the edge.
 *
+* The edge is appended to the edge array. If the graph is indexed the
+* duplicate check is a binary search; otherwise duplicates are dropped
+* the next time the index is built.
+*
 * NOTE: Undefined unless both nodes are already in the graph.
 *
 * Returns: The modified graph.
 */
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
-	struct edge *e = malloc(sizeof(struct edge));
-	e->n1 = n1;
-	e->n2 = n2;
-	dlist_insert(g->edges, e, dlist_first(g->edges));
+	if (g->indexed) {
+		int k = find_edge(g, n1->id, n2->id);
+		if (k >= 0 && g->edges[k].src >= 0) {
+			LOG_INFO("Edge %s -> %s already exists", n1->name, n2->name);
+			return g;
+		}
+		if (k >= 0) {
+			// Bring a deleted edge back to life in place.
+			g->edges[k].src = n1->id;
+			g->edgecount++;
+			g->dead--;
+			n1->version = -1;
+			return g;
+		}
+	}
+	if (g->edgeslots == g->edgecap) {
+		g->edgecap *= 2;
+		g->edges = realloc(g->edges, g->edgecap * sizeof(struct edge));
+		STATS_ADD(allocs, 1);
+	}
+	if (g->edgeslots > 0) {
+		// Appending in order keeps the array sorted.
+		struct edge *last = &g->edges[g->edgeslots - 1];
+		int src = last->src >= 0 ? last->src : ~last->src;
+		if (src > n1->id || (src == n1->id && last->dest >= n2->id)) {
+			g->sorted = false;
+		}
+	}
+	g->edges[g->edgeslots].src = n1->id;
+	g->edges[g->edgeslots].dest = n2->id;
+	g->edgeslots++;
+	g->edgecount++;
+	g->indexed = false;
+	return g;
 }
 
 /**
@@ -213,45 +452,39 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
 * @g: Graph to manipulate.
 * @n: Node to remove from the graph.
 *
+* Removes the node and every edge to or from it in one scan over the
+* edge array.
+*
 * Returns: The modified graph.
 *
 * NOTE: Undefined if the node is not in the graph.
 */
 graph *graph_delete_node(graph *g, node *n)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->edges);
-
-	while (!dlist_is_end(g->edges, pos)) {
-		// Inspect the table entry
-		struct edge *e = dlist_inspect(g->edges, pos);
-
-		if (*(e->n1->name)==*(n->name) || *(e->n2->name)==*(n->name)) {
-			dlist_remove(g->edges, pos);
-			free(e);
+	for (int k = 0; k < g->edgeslots; k++) {
+		struct edge *e = &g->edges[k];
+		if (e->src >= 0 && (e->src == n->id || e->dest == n->id)) {
+			kill_edge(g, k);
 		}
-
-		// Continue with the next position.
-		pos = dlist_next(g->edges, pos);
 	}
+	STATS_ADD(edges_scanned, g->edgeslots);
 
-	// Iterate over the list. Return first match.
-
-	pos = dlist_first(g->nodes);
-
+	dlist_pos pos = dlist_first(g->nodes);
 	while (!dlist_is_end(g->nodes, pos)) {
-		// Inspect the table entry
-		node *entry = dlist_inspect(g->nodes, pos);
-
-		if (*(entry->name)==*(n->name)) {
+		if (dlist_inspect(g->nodes, pos) == n) {
 			dlist_remove(g->nodes, pos);
-			free(n);
+			break;
 		}
-
-		// Continue with the next position.
 		pos = dlist_next(g->nodes, pos);
 	}
+	g->byid[n->id] = NULL;
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+	}
+	free(n->adj);
+	free(n);
+	g->nodecount--;
+	return g;
 }
 
 /**
@@ -266,23 +499,12 @@ graph *graph_delete_node(graph *g, node *n)
 */
 graph *graph_delete_edge(graph *g, node *n1, node *n2)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->edges);
-
-	while (!dlist_is_end(g->edges, pos)) {
-		// Inspect the table entry
-		struct edge *e = dlist_inspect(g->edges, pos);
-
-		if ((*(e->n1->name)==*(n1->name) && *(e->n2->name)==*(n2->name))
-		|| (*(e->n2->name)==*(n1->name) && *(e->n1->name)==*(n2->name))) {
-			dlist_remove(g->edges, pos);
-			free(e);
-		}
-
-		// Continue with the next position.
-		pos = dlist_next(g->edges, pos);
+	ensure_index(g);
+	int k = find_edge(g, n1->id, n2->id);
+	if (k >= 0 && g->edges[k].src >= 0) {
+		kill_edge(g, k);
 	}
+	return g;
 }
 
 /**
@@ -304,31 +526,28 @@ node *graph_choose_node(const graph *g)
 * @g: Graph to inspect.
 * @n: Node to get neighbours for.
 *
-* Returns: A pointer to a list of nodes. Note: The list must be
-* dlist_kill()-ed after use.
+* The list is made from the neighbour array of the node and cached in
+* the node until its edges change. graph_neighbours_span() avoids the
+* list altogether.
+*
+* Returns: A pointer to a list of nodes, in id order. Note: The list is
+* owned by the graph and must not be modified or dlist_kill()-ed.
 */
 dlist *graph_neighbours(const graph *g,const node *n)
 {
-	dlist *neighbours;
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(g->edges);
-
-	while (!dlist_is_end(g->edges, pos)) {
-		// Inspect the table entry
-		struct edge *e = dlist_inspect(g->edges, pos);
-
-		if (*(e->n1->name)==*(n->name) && *(e->n2->name)!=*(n->name)) {
-			dlist_insert(neighbours, e->n2, dlist_first(neighbours));
+	// Only the caches in the node change.
+	node *mn = (node *)n;
+	refresh(g, mn);
+	if (mn->neighbours == NULL) {
+		mn->neighbours = dlist_empty(NULL);
+		dlist_pos pos = dlist_first(mn->neighbours);
+		for (int k = 0; k < mn->degree; k++) {
+			pos = dlist_insert(mn->neighbours, mn->adj[k], pos);
+			pos = dlist_next(mn->neighbours, pos);
 		}
-		else if (*(e->n2->name)==*(n->name) && *(e->n1->name)!=*(n->name)) {
-			dlist_insert(neighbours, e->n1, dlist_first(neighbours));
-		}
-
-		// Continue with the next position.
-		pos = dlist_next(g->edges, pos);
+		STATS_ADD(allocs, 1 + mn->degree);
 	}
-	return neighbours;
+	return mn->neighbours;
 }
 
 /**
@@ -342,19 +561,7 @@ dlist *graph_neighbours(const graph *g,const node *n)
 void graph_kill(graph *g)
 {
 	// Iterate over the list. Destroy all elements.
-	dlist_pos pos = dlist_first(g->edges);
-
-	while (!dlist_is_end(g->edges, pos)) {
-		// Inspect the key/value pair.
-		struct edge *e = dlist_inspect(g->edges, pos);
-		// Move on to next element.
-		pos = dlist_next(g->edges, pos);
-		// Deallocate the table entry structure.
-		free(e);
-	}
-
-	// Iterate over the list. Destroy all elements.
-	pos = dlist_first(g->nodes);
+	dlist_pos pos = dlist_first(g->nodes);
 
 	while (!dlist_is_end(g->nodes, pos)) {
 		// Inspect the key/value pair.
@@ -362,12 +569,19 @@ void graph_kill(graph *g)
 		// Move on to next element.
 		pos = dlist_next(g->nodes, pos);
 		// Deallocate the table entry structure.
+		if (n->neighbours != NULL) {
+			dlist_kill(n->neighbours);
+		}
+		free(n->adj);
 		free(n);
 	}
 
 	// Kill what's left of the list...
 	dlist_kill(g->nodes);
-	dlist_kill(g->edges);
+	free(g->edges);
+	free(g->first);
+	free(g->byid);
+	free(g->seen);
 	// ...and the table.
 	free(g);
 }
@@ -376,11 +590,189 @@ void graph_kill(graph *g)
 * graph_print() - Iterate over the graph elements and print their values.
 * @g: Graph to inspect.
 *
-* Iterates over the graph and prints its contents.
+* Prints the number of nodes and edges followed by one "SRC DEST" line
+* per edge, in source id order.
 *
 * Returns: Nothing.
 */
 void graph_print(const graph *g)
 {
+	ensure_index(g);
+	printf("%d nodes, %d edges\n", g->nodecount, g->edgecount);
+	for (int k = 0; k < g->edgeslots; k++) {
+		if (g->edges[k].src < 0) {
+			continue;
+		}
+		printf("%s %s\n", g->byid[g->edges[k].src]->name,
+			g->byid[g->edges[k].dest]->name);
+	}
+}
+
+// ===========EXTENDED INTERFACE (graph_ext.h)============
+
+/**
+* graph_nodecount() - Return the number of nodes in the graph.
+* @g: Graph to inspect.
+*
+* Returns: The number of nodes.
+*/
+int graph_nodecount(const graph *g)
+{
+	return g->nodecount;
+}
+
+/**
+* graph_edgecount() - Return the number of edges in the graph.
+* @g: Graph to inspect.
+*
+* Duplicate edges inserted while the graph was not indexed are only
+* dropped when it is, so this builds the index if needed.
+*
+* Returns: The number of edges.
+*/
+int graph_edgecount(const graph *g)
+{
+	ensure_index(g);
+	return g->edgecount;
+}
+
+/**
+* graph_id_bound() - Return an upper bound on the node ids in the graph.
+* @g: Graph to inspect.
+*
+* Returns: A value larger than every id handed out by graph_node_id().
+*/
+int graph_id_bound(const graph *g)
+{
+	return g->nextid;
+}
+
+/**
+* graph_node_id() - Return the id of a node.
+* @n: Node to inspect.
+*
+* Ids are handed out in insertion order and never reused, so they stay
+* valid for as long as the node is in the graph.
+*
+* Returns: The id of the node.
+*/
+int graph_node_id(const node *n)
+{
+	return n->id;
+}
+
+/**
+* graph_node_name() - Return the name of a node.
+* @n: Node to inspect.
+*
+* Returns: A pointer to the name stored in the node.
+*/
+const char *graph_node_name(const node *n)
+{
+	return n->name;
+}
+
+/**
+* graph_nodes() - Return the list of nodes in the graph.
+* @g: Graph to inspect.
+*
+* Returns: A pointer to the internal list of nodes. Note: The list is
+* owned by the graph and must not be modified or dlist_kill()-ed.
+*/
+dlist *graph_nodes(const graph *g)
+{
+	return g->nodes;
+}
+
+/**
+* graph_try_find_node() - Find a node stored in the graph.
+* @g: Graph to inspect.
+* @s: Node name.
+*
+* Returns: A pointer to the found node, or NULL if there is no node with
+* the given name.
+*/
+node *graph_try_find_node(const graph *g, const char *s)
+{
+	// Iterate over the list. Return first match.
+
+	dlist_pos pos = dlist_first(g->nodes);
+
+	while (!dlist_is_end(g->nodes, pos)) {
+		// Inspect the table entry
+		node *n = dlist_inspect(g->nodes, pos);
+		STATS_ADD(lookup_probes, 1);
+		// Check if the entry key matches the search key.
+		if (!strcmp(n->name, s)) {
+			return n;
+		}
+		// Continue with the next position.
+		pos = dlist_next(g->nodes, pos);
+	}
+	return NULL;
+}
+
+/**
+* graph_find_nodes() - Find many nodes stored in the graph.
+* @g: Graph to inspect.
+* @names: Node names to look up.
+* @count: Number of names.
+* @out: Array of count pointers to store the found nodes in. Names
+*       that are not in the graph get NULL.
+*
+* Returns: The number of names that were found.
+*/
+int graph_find_nodes(const graph *g, const char **names, int count, node **out)
+{
+	int found = 0;
+	for (int k = 0; k < count; k++) {
+		out[k] = graph_try_find_node(g, names[k]);
+		if (out[k] != NULL) {
+			found++;
+		}
+	}
+	return found;
+}
+
+/**
+* graph_edges() - Copy out all edges of the graph.
+* @g: Graph to inspect.
+* @src: Array of graph_edgecount() entries for the source node ids.
+* @dest: Array of graph_edgecount() entries for the destination node ids.
+*
+* The edges come out sorted by source and then destination id.
+*
+* Returns: The number of edges copied.
+*/
+int graph_edges(const graph *g, int *src, int *dest)
+{
+	int m = 0;
+	ensure_index(g);
+	for (int k = 0; k < g->edgeslots; k++) {
+		if (g->edges[k].src >= 0) {
+			src[m] = g->edges[k].src;
+			dest[m] = g->edges[k].dest;
+			m++;
+		}
+	}
+	STATS_ADD(edges_scanned, g->edgeslots);
+	return m;
+}
 
+/**
+* graph_neighbours_span() - Return the neighbours of a node as an array.
+* @g: Graph to inspect.
+* @n: Node to get neighbours for.
+* @count: Where to store the number of neighbours.
+*
+* Returns: A pointer to the *count neighbours, in id order. Note: The
+* array is owned by the graph and is only valid until the next change
+* to the edges of the graph.
+*/
+node *const *graph_neighbours_span(const graph *g, const node *n, int *count)
+{
+	node *mn = (node *)n;
+	refresh(g, mn);
+	*count = mn->degree;
+	return mn->adj;
 }
@@ -1,8 +1,11 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "graph.h"
+#include "shortname.h"
+#include "log.h"
 
 /*
 * Implementation of a graph.
@@ -19,6 +22,8 @@ struct node {
 	char name[41];
 	bool seen;
 	dlist *neighbours;
+	shortname key;	// The name packed for fast compares.
+	bool whole;	// True if key holds the whole name.
 };
 
 struct graph {
@@ -40,19 +45,10 @@ struct graph {
 */
 bool nodes_are_equal(const node *n1,const node *n2)
 {
-	int i = 0;
-	while (n1->name[i] != '\0' && n2->name[i] != '\0') {
-		if (n1->name[i] != n2->name[i]) {
-			return false;
-		}
-		i++;
-	}
-	if (n1->name[i] == '\0' && n2->name[i] == '\0') {
-		return true;
-	}
-	else {
-		return false;
-	}
+	// Names of up to SHORTNAME_LEN bytes are equal exactly when their
+	// packed forms are; longer ones also need a full compare.
+	return shortname_equal(&n1->key, &n2->key)
+		&& (n1->whole || !strcmp(n1->name, n2->name));
 }
 
 /**
@@ -111,11 +107,11 @@ graph *graph_insert_node(graph *g, const char *s)
 		int i = 0;
 		while (s[i] != '\0') {
 			n->name[i] = s[i];
-			printf("%c", s[i]);
 			i++;
 		}
 		n->name[i] = '\0';
-		printf(" ");
+		n->whole = shortname_pack(n->name, &n->key);
+		LOG_DEBUG("insert node %s", n->name);
 		// Iterate over the list. Return first match.
 		dlist_pos pos = dlist_first(g->nodes);
 
@@ -124,7 +120,7 @@ graph *graph_insert_node(graph *g, const char *s)
 			node *entry = dlist_inspect(g->nodes, pos);
 			// Check if the entry key matches the search key.
 			if (nodes_are_equal(n,entry)) {
-				printf("Warning: A node with that name already exists in the graph!");
+				LOG_INFO("A node with the name %s already exists in the graph", n->name);
 				free(n);
 				return g;
 			}
@@ -133,12 +129,12 @@ graph *graph_insert_node(graph *g, const char *s)
 		}
 		dlist_insert(g->nodes, n, dlist_first(g->nodes));
 		g->nodecount++;
-		printf("\ninit %d", n->seen);
+		LOG_DEBUG("init %d", n->seen);
 		return g;
 	}
 	else
 	{
-		printf("Warning: Graph full!");
+		LOG_WARN("Graph full, node %s not inserted", s);
 		return g;
 	}
 }
@@ -152,31 +148,25 @@ graph *graph_insert_node(graph *g, const char *s)
 */
 node *graph_find_node(const graph *g, const char *s)
 {
+	shortname key;
+	bool whole = shortname_pack(s, &key);
 	// Iterate over the list. Return first match.
 
 	dlist_pos pos = dlist_first(g->nodes);
 
 	while (!dlist_is_end(g->nodes, pos)) {
-		bool check = true;
 		// Inspect the table entry
 		node *n = dlist_inspect(g->nodes, pos);
-		printf("\nname %s", n->name);
-		printf(" search %s", s);
+		LOG_DEBUG("name %s search %s", n->name, s);
 		// Check if the entry key matches the search key.
-		int i = 0;
-		while (n->name[i] != '\0' && s[i] != '\0' && check == true) {
-			if (n->name[i] != s[i]) {
-				check = false;
-			}
-			i++;
-		}
-		if (n->name[i] == '\0' && s[i] == '\0' && check == true) {
+		if (shortname_equal(&n->key, &key)
+			&& (whole || !strcmp(n->name, s))) {
 			return n;
 		}
 		// Continue with the next position.
 		pos = dlist_next(g->nodes, pos);
 	}
-	printf("\nWarning: Node does not exist!");
+	LOG_ERROR("Node with name %s does not exist", s);
 	exit(EXIT_FAILURE);
 }
 
@@ -251,7 +241,7 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
 		node *n = dlist_inspect(n1->neighbours, pos);
 
 		if (nodes_are_equal(n,n2)) {
-			printf("Warning: Edge already exist!");
+			LOG_INFO("Edge already exists");
 			return g;
 		}
 
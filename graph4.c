@@ -1,8 +1,17 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "graph.h"
+#include "graph_ext.h"
+#include "ingest.h"
+#include "batch.h"
+#include "shortname.h"
+#include "stats.h"
+#include "log.h"
 
 /*
  * Implementation of a graph.
@@ -17,8 +26,18 @@
 
 struct node {
   char name[41];
-  bool seen;
+  int id;
   dlist *neighbours;
+  // The same neighbours as an array, in insertion order, for
+  // graph_neighbours_span().
+  node **adj;
+  int degree;
+  int adjcap;
+  // Next node in the same bucket while ingesting, see
+  // graph_ingest_begin().
+  node *hnext;
+  // The name packed for fast compares, see shortname.h.
+  shortname key;
 };
 
 struct graph {
@@ -26,10 +45,88 @@ struct graph {
   int edgecount;
   int nodecount;
   int maxnodes;
+  int nextid;
+  // Seen flags live here, indexed by node id, so that searches never
+  // write to the nodes themselves.
+  bool *seen;
+  int seencap;
+  // Packed names and nodes by id, with the same capacity as seen. Ids
+  // of deleted nodes get dead_key and NULL.
+  shortname *keys;
+  node **byid;
+  // Only set between graph_ingest_begin() and graph_ingest_end().
+  struct ingest *ingest;
+  // Bumped on every change, see graph_version().
+  long version;
 };
 
+// Packed form of no short name, since its last byte is not zero.
+static const shortname dead_key = { { ~0ULL, ~0ULL } };
+
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+/*
+ * Make room for ids up to bound in the arrays indexed by node id.
+ */
+static void grow_ids(graph *g, int bound)
+{
+  if (bound <= g->seencap) {
+    return;
+  }
+  int old = g->seencap;
+  while (g->seencap < bound) {
+    g->seencap = g->seencap ? 2 * g->seencap : 16;
+  }
+  g->seen = realloc(g->seen, g->seencap * sizeof(bool));
+  g->keys = realloc(g->keys, g->seencap * sizeof(shortname));
+  g->byid = realloc(g->byid, g->seencap * sizeof(node *));
+  for (int i = old; i < g->seencap; i++) {
+    g->seen[i] = false;
+    g->keys[i] = dead_key;
+    g->byid[i] = NULL;
+  }
+}
+
+/*
+ * Check if node n has the name s, packed as key. whole tells if the
+ * packed form is the whole name.
+ */
+static bool node_named(const node *n, const shortname *key, bool whole,
+  const char *s)
+{
+  return shortname_equal(&n->key, key) && (whole || !strcmp(n->name, s));
+}
+
+/*
+ * Find the node named s by a scan over the packed names of all ids.
+ * Nodes made by an unfinished ingest have no entry yet and are not seen.
+ */
+static node *find_named(const graph *g, const char *s)
+{
+  shortname key;
+  bool whole = shortname_pack(s, &key);
+  int bound = g->nextid < g->seencap ? g->nextid : g->seencap;
+  int i = shortname_scan(g->keys, 0, bound, &key);
+  while (i >= 0) {
+    node *n = g->byid[i];
+    STATS_ADD(lookup_probes, 1);
+    if (n != NULL && node_named(n, &key, whole, s)) {
+      return n;
+    }
+    i = shortname_scan(g->keys, i + 1, bound, &key);
+  }
+  return NULL;
+}
+
+/*
+ * Forget the packed name of a node that is being deleted.
+ */
+static void drop_id(graph *g, const node *n)
+{
+  g->keys[n->id] = dead_key;
+  g->byid[n->id] = NULL;
+}
+
 /**
  * nodes_are_equal() - Check whether two nodes are equal.
  * @n1: Pointer to node 1.
@@ -55,6 +152,14 @@ graph *graph_empty(int max_nodes)
   g->nodes = dlist_empty(NULL);
   g->maxnodes = max_nodes;
   g->nodecount = 0;
+  g->edgecount = 0;
+  g->nextid = 0;
+  g->seen = NULL;
+  g->seencap = 0;
+  g->keys = NULL;
+  g->byid = NULL;
+  g->ingest = NULL;
+  g->version = 0;
   return g;
 }
 
@@ -93,31 +198,32 @@ bool graph_has_edges(const graph *g)
 graph *graph_insert_node(graph *g, const char *s)
 {
   if (g->nodecount < g->maxnodes) {
-    // Iterate over the list. Return first match.
-    dlist_pos pos = dlist_first(g->nodes);
-
-    while (!dlist_is_end(g->nodes, pos)) {
-      // Inspect the table entry
-      node *n = dlist_inspect(g->nodes, pos);
-      // Check if the entry key matches the search key.
-      if (!strcmp(n->name, s)) {
-        printf("Warning: A node with that name already exists in the graph!");
-        return g;
-      }
-      // Continue with the next position.
-      pos = dlist_next(g->nodes, pos);
+    if (find_named(g, s) != NULL) {
+      LOG_INFO("A node with the name %s already exists in the graph", s);
+      return g;
     }
     node *n = malloc(sizeof(node));
-    n->seen = false;
+    STATS_ADD(allocs, 3);
+    n->id = g->nextid++;
+    grow_ids(g, g->nextid);
+    g->seen[n->id] = false;
     n->neighbours = dlist_empty(NULL);
+    n->adj = NULL;
+    n->degree = 0;
+    n->adjcap = 0;
+    n->hnext = NULL;
     strcpy(n->name, s);
+    shortname_pack(s, &n->key);
+    g->keys[n->id] = n->key;
+    g->byid[n->id] = n;
     dlist_insert(g->nodes, n, dlist_first(g->nodes));
     g->nodecount++;
+    g->version++;
     return g;
   }
   else
   {
-    printf("Warning: Graph full!");
+    LOG_WARN("Graph full, node %s not inserted", s);
     return g;
   }
 }
@@ -127,28 +233,19 @@ graph *graph_insert_node(graph *g, const char *s)
  * @g: Graph to manipulate.
  * @s: Node identifier, e.g. a char *.
  *
- * Returns: A pointer to the found node, or NULL.
+ * Returns: A pointer to the found node.
+ *
+ * NOTE: Exits the program if there is no node with the given name. Use
+ * graph_try_find_node() where a missing name is not fatal.
  */
 node *graph_find_node(const graph *g, const char *s)
 {
-  	// Iterate over the list. Return first match.
-
-  	dlist_pos pos = dlist_first(g->nodes);
-
-  	while (!dlist_is_end(g->nodes, pos)) {
-  		// Inspect the table entry
-  		node *n = dlist_inspect(g->nodes, pos);
-      printf("\nname %s", n->name);
-      printf(" search %s", s);
-  		// Check if the entry key matches the search key.
-      if (!strcmp(n->name, s)) {
-        return n;
-      }
-  		// Continue with the next position.
-  		pos = dlist_next(g->nodes, pos);
-  	}
-    printf("\nWarning: Node with name %s does not exist!", s);
+  node *n = graph_try_find_node(g, s);
+  if (n == NULL) {
+    LOG_ERROR("Node with name %s does not exist", s);
     exit(EXIT_FAILURE);
+  }
+  return n;
 }
 
 /**
@@ -160,7 +257,7 @@ node *graph_find_node(const graph *g, const char *s)
  */
 bool graph_node_is_seen(const graph *g, const node *n)
 {
-  return n->seen;
+  return g->seen[n->id];
 }
 
 /**
@@ -173,7 +270,7 @@ bool graph_node_is_seen(const graph *g, const node *n)
  */
 graph *graph_node_set_seen(graph *g, node *n, bool seen)
 {
-  n->seen = seen;
+  g->seen[n->id] = seen;
   return g;
 }
 
@@ -185,20 +282,8 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen)
  */
 graph *graph_reset_seen(graph *g)
 {
-  	// Iterate over the list. Return first match.
-
-  	dlist_pos pos = dlist_first(g->nodes);
-
-  	while (!dlist_is_end(g->nodes, pos)) {
-  		// Inspect the table entry
-  		node *entry = dlist_inspect(g->nodes, pos);
-
-      entry->seen = false;
-
-  		// Continue with the next position.
-  		pos = dlist_next(g->nodes, pos);
-  	}
-    return g;
+  memset(g->seen, 0, g->nextid * sizeof(bool));
+  return g;
 }
 
 /**
@@ -213,24 +298,22 @@ graph *graph_reset_seen(graph *g)
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
-	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(n1->neighbours);
-
-	while (!dlist_is_end(n1->neighbours, pos)) {
-		// Inspect the table entry
-		node *n = dlist_inspect(n1->neighbours, pos);
-
-    if (nodes_are_equal(n,n2)) {
-      printf("Warning: Edge already exist!");
+  for (int k = 0; k < n1->degree; k++) {
+    if (nodes_are_equal(n1->adj[k], n2)) {
+      LOG_INFO("Edge %s -> %s already exists", n1->name, n2->name);
       return g;
     }
-
-		// Continue with the next position.
-		pos = dlist_next(n->neighbours, pos);
-	}
+  }
+  if (n1->degree == n1->adjcap) {
+    n1->adjcap = n1->adjcap ? 2 * n1->adjcap : 4;
+    n1->adj = realloc(n1->adj, n1->adjcap * sizeof(node *));
+    STATS_ADD(allocs, 1);
+  }
+  n1->adj[n1->degree++] = n2;
   dlist_insert(n1->neighbours, n2, dlist_first(n1->neighbours));
+  STATS_ADD(allocs, 1);
   g->edgecount++;
+  g->version++;
   return g;
 }
 
@@ -266,15 +349,23 @@ graph *graph_delete_node(graph *g, node *n)
 		node *ni = dlist_inspect(g->nodes, pos);
 
     if (nodes_are_equal(ni, n)) {
-      dlist_remove(g->nodes, pos);
+      // Drop the outgoing edges along with the node.
+      g->edgecount -= n->degree;
+      drop_id(g, n);
+      dlist_kill(n->neighbours);
+      free(n->adj);
       free(n);
       g->nodecount--;
+      // dlist_remove() returns the position after the removed element.
+      pos = dlist_remove(g->nodes, pos);
+      continue;
     }
 
 		// Continue with the next position.
 		pos = dlist_next(g->nodes, pos);
 	}
 
+  g->version++;
   return g;
 }
 
@@ -299,13 +390,23 @@ graph *graph_delete_edge(graph *g, node *n1, node *n2)
 		node *n = dlist_inspect(n1->neighbours, pos);
 
     if (nodes_are_equal(n,n2)) {
-      dlist_remove(n1->neighbours, pos);
+      // dlist_remove() returns the position after the removed element.
+      pos = dlist_remove(n1->neighbours, pos);
       g->edgecount--;
+      continue;
     }
 
 		// Continue with the next position.
 		pos = dlist_next(n1->neighbours, pos);
 	}
+  for (int k = 0; k < n1->degree; k++) {
+    if (nodes_are_equal(n1->adj[k], n2)) {
+      memmove(n1->adj + k, n1->adj + k + 1, (n1->degree - k - 1) * sizeof(node *));
+      n1->degree--;
+      break;
+    }
+  }
+  g->version++;
   return g;
 }
 
@@ -328,8 +429,9 @@ node *graph_choose_node(const graph *g)
  * @g: Graph to inspect.
  * @n: Node to get neighbours for.
  *
- * Returns: A pointer to a list of nodes. Note: The list must be
- * dlist_kill()-ed after use.
+ * Returns: A pointer to a list of nodes, newest edge first. Note: The
+ * list is owned by the graph and must not be modified or dlist_kill()-ed.
+ * It changes when edges from the node are inserted or deleted.
  */
 dlist *graph_neighbours(const graph *g,const node *n)
 {
@@ -346,6 +448,9 @@ dlist *graph_neighbours(const graph *g,const node *n)
  */
 void graph_kill(graph *g)
 {
+  if (g->ingest != NULL) {
+    graph_ingest_end(g);
+  }
   // Iterate over the list. Destroy all elements.
   dlist_pos pos = dlist_first(g->nodes);
 
@@ -356,12 +461,16 @@ void graph_kill(graph *g)
   	pos = dlist_next(g->nodes, pos);
     // Deallocate the table entry structure.
     dlist_kill(n->neighbours);
+    free(n->adj);
     free(n);
   }
 
   // Kill what's left of the list...
   dlist_kill(g->nodes);
   // ...and the table.
+  free(g->seen);
+  free(g->keys);
+  free(g->byid);
   free(g);
 }
 
@@ -369,94 +478,640 @@ void graph_kill(graph *g)
  * graph_print() - Iterate over the graph elements and print their values.
  * @g: Graph to inspect.
  *
- * Iterates over the graph and prints its contents.
+ * Prints the graph as a table with a row and a column per node, in the
+ * order of the node list. A cell is YES if there is an edge from the
+ * node of the column to the node of the row. The table is made one row
+ * at a time, so apart from the output this takes O(nodes + edges) time
+ * and memory. For large graphs, see graph_export() in export.h.
  *
  * Returns: Nothing.
  */
 void graph_print(const graph *g)
 {
-  int array[g->nodecount][g->nodecount];
-  for (int i = 0; i < g->nodecount; i++) {
-    for (int j = 0; j < g->nodecount; j++) {
-      array[i][j] = 0;
+  int n = g->nodecount;
+  int *index = malloc((g->nextid + 1) * sizeof(int));
+  node **order = malloc((n + 1) * sizeof(node *));
+  int *in_off = calloc(n + 2, sizeof(int));
+  int *in = malloc((g->edgecount + 1) * sizeof(int));
+  bool *mark = calloc(n + 1, sizeof(bool));
+
+  // Number the nodes in list order, then list the sources of the edges
+  // into every node.
+  int x = 0;
+  dlist_pos pos = dlist_first(g->nodes);
+  while (!dlist_is_end(g->nodes, pos)) {
+    order[x] = dlist_inspect(g->nodes, pos);
+    index[order[x]->id] = x;
+    x++;
+    pos = dlist_next(g->nodes, pos);
+  }
+  for (x = 0; x < n; x++) {
+    for (int k = 0; k < order[x]->degree; k++) {
+      in_off[index[order[x]->adj[k]->id] + 2]++;
+    }
+  }
+  for (int y = 0; y < n; y++) {
+    in_off[y + 2] += in_off[y + 1];
+  }
+  for (x = 0; x < n; x++) {
+    for (int k = 0; k < order[x]->degree; k++) {
+      in[in_off[index[order[x]->adj[k]->id] + 1]++] = x;
     }
   }
 
-  dlist_pos pos1 = dlist_first(g->nodes);
+  printf("\n     |");
+  for (x = 0; x < n; x++) {
+    printf(" %s |", order[x]->name);
+  }
+  printf("\n");
+  for (int i = 0; i < n + 1; i++) {
+    fputs("------", stdout);
+  }
+  printf("\n");
+  for (int y = 0; y < n; y++) {
+    for (int k = in_off[y]; k < in_off[y + 1]; k++) {
+      mark[in[k]] = true;
+    }
+    printf(" %s |", order[y]->name);
+    for (x = 0; x < n; x++) {
+      fputs(mark[x] ? " YES |" : " NON |", stdout);
+    }
+    printf("\n");
+    for (int i = 0; i < n + 1; i++) {
+      fputs("------", stdout);
+    }
+    printf("\n");
+    for (int k = in_off[y]; k < in_off[y + 1]; k++) {
+      mark[in[k]] = false;
+    }
+  }
 
-  int x = 0;
-  int y = 0;
-  while (!dlist_is_end(g->nodes, pos1)) {
-  	// Inspect the key/value pair.
-  	node *n1 = dlist_inspect(g->nodes, pos1);
+  free(mark);
+  free(in);
+  free(in_off);
+  free(order);
+  free(index);
+}
+
+// ===========EXTENDED INTERFACE (graph_ext.h)============
+
+/**
+ * graph_nodecount() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_nodecount(const graph *g)
+{
+  return g->nodecount;
+}
+
+/**
+ * graph_edgecount() - Return the number of edges in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of edges.
+ */
+int graph_edgecount(const graph *g)
+{
+  return g->edgecount;
+}
+
+/**
+ * graph_id_bound() - Return an upper bound on the node ids in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A value larger than every id handed out by graph_node_id().
+ */
+int graph_id_bound(const graph *g)
+{
+  return g->nextid;
+}
+
+/**
+ * graph_node_id() - Return the id of a node.
+ * @n: Node to inspect.
+ *
+ * Ids are handed out in insertion order and never reused, so they stay
+ * valid for as long as the node is in the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const node *n)
+{
+  return n->id;
+}
 
+/**
+ * graph_node_name() - Return the name of a node.
+ * @n: Node to inspect.
+ *
+ * Returns: A pointer to the name stored in the node.
+ */
+const char *graph_node_name(const node *n)
+{
+  return n->name;
+}
 
-    dlist_pos pos2 = dlist_first(n1->neighbours);
+/**
+ * graph_nodes() - Return the list of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the internal list of nodes. Note: The list is
+ * owned by the graph and must not be modified or dlist_kill()-ed.
+ */
+dlist *graph_nodes(const graph *g)
+{
+  return g->nodes;
+}
 
-    while (!dlist_is_end(n1->neighbours, pos2)) {
-    	// Inspect the key/value pair.
-    	node *n2 = dlist_inspect(n1->neighbours, pos2);
+/**
+ * graph_try_find_node() - Find a node stored in the graph.
+ * @g: Graph to inspect.
+ * @s: Node name.
+ *
+ * Scans the packed names of all node ids (see shortname.h) instead of
+ * walking the node list, so a short name costs one 16-byte compare per
+ * node.
+ *
+ * Returns: A pointer to the found node, or NULL if there is no node with
+ * the given name.
+ */
+node *graph_try_find_node(const graph *g, const char *s)
+{
+  LOG_DEBUG("search %s", s);
+  return find_named(g, s);
+}
 
-        dlist_pos pos3 = dlist_first(g->nodes);
+/*
+ * Hash function for node names (FNV-1a).
+ */
+static unsigned name_hash(const char *s)
+{
+  unsigned h = 2166136261u;
+  while (*s) {
+    h = (h ^ (unsigned char)*s++) * 16777619u;
+  }
+  return h;
+}
 
-        y = 0;
-        while (!dlist_is_end(g->nodes, pos3)) {
-        	// Inspect the key/value pair.
-        	node *n3 = dlist_inspect(g->nodes, pos3);
+/**
+ * graph_find_nodes() - Find many nodes in one pass over the graph.
+ * @g: Graph to inspect.
+ * @names: Node names to look up.
+ * @count: Number of names.
+ * @out: Array of count pointers to store the found nodes in. Names
+ *       that are not in the graph get NULL.
+ *
+ * The names are put in a temporary hash table and the node list is
+ * walked once, so resolving k names costs O(nodes + k) instead of
+ * O(nodes * k) with repeated graph_find_node() calls. The walk stops as
+ * soon as every name has been found.
+ *
+ * Returns: The number of names that were found.
+ */
+int graph_find_nodes(const graph *g, const char **names, int count, node **out)
+{
+  int cap = 16;
+  while (cap < 2 * count) {
+    cap *= 2;
+  }
+  // slots[] holds the first index of each distinct name, same[] chains
+  // further indices asking for the same name.
+  int *slots = malloc(cap * sizeof(int));
+  int *same = malloc((count + 1) * sizeof(int));
+  int distinct = 0;
+  int found = 0;
 
-          if (nodes_are_equal(n2, n3))
-          {
-            array[y][x] = 1;
-          }
+  for (int i = 0; i < cap; i++) {
+    slots[i] = -1;
+  }
+  for (int k = 0; k < count; k++) {
+    out[k] = NULL;
+    same[k] = -1;
+    unsigned i = name_hash(names[k]) & (cap - 1);
+    while (slots[i] >= 0 && strcmp(names[slots[i]], names[k])) {
+      i = (i + 1) & (cap - 1);
+    }
+    if (slots[i] < 0) {
+      slots[i] = k;
+      distinct++;
+    } else {
+      same[k] = same[slots[i]];
+      same[slots[i]] = k;
+    }
+  }
 
-        	// Move on to next element.
-        	pos3 = dlist_next(g->nodes, pos3);
-          y++;
+  dlist_pos pos = dlist_first(g->nodes);
+  while (distinct > 0 && !dlist_is_end(g->nodes, pos)) {
+    node *n = dlist_inspect(g->nodes, pos);
+    unsigned i = name_hash(n->name) & (cap - 1);
+    while (slots[i] >= 0) {
+      STATS_ADD(lookup_probes, 1);
+      if (!strcmp(names[slots[i]], n->name)) {
+        for (int k = slots[i]; k >= 0; k = same[k]) {
+          out[k] = n;
+          found++;
         }
+        distinct--;
+        break;
+      }
+      i = (i + 1) & (cap - 1);
+    }
+    pos = dlist_next(g->nodes, pos);
+  }
+
+  free(slots);
+  free(same);
+  return found;
+}
 
-    	// Move on to next element.
-    	pos2 = dlist_next(n1->neighbours, pos2);
+/**
+ * graph_edges() - Copy out all edges of the graph.
+ * @g: Graph to inspect.
+ * @src: Array of graph_edgecount() entries for the source node ids.
+ * @dest: Array of graph_edgecount() entries for the destination node ids.
+ *
+ * Returns: The number of edges copied.
+ */
+int graph_edges(const graph *g, int *src, int *dest)
+{
+  int m = 0;
+  dlist_pos pos = dlist_first(g->nodes);
+  while (!dlist_is_end(g->nodes, pos)) {
+    node *n = dlist_inspect(g->nodes, pos);
+    for (int k = 0; k < n->degree; k++) {
+      src[m] = n->id;
+      dest[m] = n->adj[k]->id;
+      m++;
     }
+    pos = dlist_next(g->nodes, pos);
+  }
+  STATS_ADD(edges_scanned, m);
+  return m;
+}
 
-  	// Move on to next element.
-  	pos1 = dlist_next(g->nodes, pos1);
-    x++;
+/**
+ * graph_neighbours_span() - Return the neighbours of a node as an array.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @count: Where to store the number of neighbours.
+ *
+ * Walking the array needs no call per neighbour, so a traversal can
+ * keep its inner loop free of function calls. See also
+ * GRAPH_FOR_EACH_NEIGHBOUR() in graph_ext.h.
+ *
+ * Returns: A pointer to the *count neighbours, in insertion order. Note:
+ * The array is owned by the graph and is only valid until the next
+ * insert or delete of an edge from the node.
+ */
+node *const *graph_neighbours_span(const graph *g, const node *n, int *count)
+{
+  (void)g;
+  *count = n->degree;
+  return n->adj;
+}
+
+// ===========CONCURRENT INSERTION============
+
+#define INGEST_STRIPES 1024
+
+/*
+ * Spin lock on its own cache line, so that threads working on different
+ * stripes do not slow each other down.
+ */
+struct stripe {
+  int held;
+  char pad[64 - sizeof(int)];
+};
+
+struct ingest {
+  // Name hash table, chained through node->hnext.
+  node **bucket;
+  unsigned mask;
+  // Nodes with an id from here on were made by graph_ingest_node().
+  int firstid;
+  // Bucket b is guarded by lock[b % INGEST_STRIPES], the edges from node
+  // n by lock[n->id % INGEST_STRIPES]. No thread holds two at a time.
+  struct stripe lock[INGEST_STRIPES];
+};
+
+static void stripe_lock(struct stripe *l)
+{
+  while (__atomic_exchange_n(&l->held, 1, __ATOMIC_ACQUIRE)) {
+    // Wait until it looks free before trying again. The holder may have
+    // been preempted, so give up the processor if that takes a while.
+    for (int spins = 0; __atomic_load_n(&l->held, __ATOMIC_RELAXED); spins++) {
+      if (spins >= 64) {
+        sched_yield();
+      }
+    }
   }
-  printf("\n     |");
-  dlist_pos pos4 = dlist_first(g->nodes);
+}
 
-  while (!dlist_is_end(g->nodes, pos4)) {
-  	// Inspect the key/value pair.
-  	node *n4 = dlist_inspect(g->nodes, pos4);
+static void stripe_unlock(struct stripe *l)
+{
+  __atomic_store_n(&l->held, 0, __ATOMIC_RELEASE);
+}
 
-    printf(" %s |", n4->name);
+/**
+ * graph_ingest_begin() - Start inserting into the graph from many threads.
+ * @g: Graph to manipulate.
+ *
+ * Until graph_ingest_end(), graph_ingest_node() and graph_ingest_edge()
+ * may be called from any number of threads at once, and no other
+ * function may be used on the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_ingest_begin(graph *g)
+{
+  unsigned cap = 16;
+  while (cap < 2u * g->nodecount || (cap < 2u * g->maxnodes && cap < 1u << 22)) {
+    cap *= 2;
+  }
+  struct ingest *in = calloc(1, sizeof(struct ingest));
+  in->bucket = calloc(cap, sizeof(node *));
+  in->mask = cap - 1;
+  in->firstid = g->nextid;
 
-  	// Move on to next element.
-  	pos4 = dlist_next(g->nodes, pos4);
-    y++;
+  dlist_pos pos = dlist_first(g->nodes);
+  while (!dlist_is_end(g->nodes, pos)) {
+    node *n = dlist_inspect(g->nodes, pos);
+    unsigned b = name_hash(n->name) & in->mask;
+    n->hnext = in->bucket[b];
+    in->bucket[b] = n;
+    pos = dlist_next(g->nodes, pos);
   }
-  printf("\n");
-  for (int i = 0; i < g->nodecount + 1; i++) {
-    printf("------");
+  g->ingest = in;
+  return g;
+}
+
+/**
+ * graph_ingest_node() - Find or insert a node, safe to call concurrently.
+ * @g: Graph to manipulate, between graph_ingest_begin() and
+ *     graph_ingest_end().
+ * @s: Node name.
+ *
+ * Returns: The node with the given name, which is created if needed,
+ * or NULL if the graph is full. New nodes get their ids in the order
+ * they were made, but only show up in the node list after
+ * graph_ingest_end().
+ */
+node *graph_ingest_node(graph *g, const char *s)
+{
+  struct ingest *in = g->ingest;
+  unsigned b = name_hash(s) & in->mask;
+  struct stripe *l = &in->lock[b % INGEST_STRIPES];
+  shortname key;
+  bool whole = shortname_pack(s, &key);
+
+  stripe_lock(l);
+  for (node *n = in->bucket[b]; n != NULL; n = n->hnext) {
+    STATS_ADD(lookup_probes, 1);
+    if (node_named(n, &key, whole, s)) {
+      stripe_unlock(l);
+      return n;
+    }
   }
-  printf("\n");
-  dlist_pos pos5 = dlist_first(g->nodes);
-  for (int i = 0; i < g->nodecount; i++) {
-  	node *n5 = dlist_inspect(g->nodes, pos5);
-    printf(" %s |", n5->name);
-    for (int j = 0; j < g->nodecount; j++) {
-      if (array[i][j] == 0) {
-        printf(" NON |");
+  if (__atomic_fetch_add(&g->nodecount, 1, __ATOMIC_RELAXED) >= g->maxnodes) {
+    __atomic_fetch_sub(&g->nodecount, 1, __ATOMIC_RELAXED);
+    stripe_unlock(l);
+    LOG_WARN("Graph full, node %s not inserted", s);
+    return NULL;
+  }
+  node *n = malloc(sizeof(node));
+  STATS_ADD(allocs, 2);
+  n->id = __atomic_fetch_add(&g->nextid, 1, __ATOMIC_RELAXED);
+  n->neighbours = dlist_empty(NULL);
+  n->adj = NULL;
+  n->degree = 0;
+  n->adjcap = 0;
+  strcpy(n->name, s);
+  n->key = key;
+  n->hnext = in->bucket[b];
+  in->bucket[b] = n;
+  stripe_unlock(l);
+  return n;
+}
+
+/**
+ * graph_ingest_edge() - Insert an edge, safe to call concurrently.
+ * @g: Graph to manipulate, between graph_ingest_begin() and
+ *     graph_ingest_end().
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Like graph_insert_edge(), but only the edges from n1 are locked while
+ * the edge goes in, so edges from different nodes go in in parallel.
+ *
+ * Returns: true if the edge was inserted, false if it already existed.
+ */
+bool graph_ingest_edge(graph *g, node *n1, node *n2)
+{
+  struct stripe *l = &g->ingest->lock[n1->id % INGEST_STRIPES];
+
+  stripe_lock(l);
+  for (int k = 0; k < n1->degree; k++) {
+    if (nodes_are_equal(n1->adj[k], n2)) {
+      stripe_unlock(l);
+      return false;
+    }
+  }
+  if (n1->degree == n1->adjcap) {
+    n1->adjcap = n1->adjcap ? 2 * n1->adjcap : 4;
+    n1->adj = realloc(n1->adj, n1->adjcap * sizeof(node *));
+    STATS_ADD(allocs, 1);
+  }
+  n1->adj[n1->degree++] = n2;
+  dlist_insert(n1->neighbours, n2, dlist_first(n1->neighbours));
+  STATS_ADD(allocs, 1);
+  stripe_unlock(l);
+  __atomic_fetch_add(&g->edgecount, 1, __ATOMIC_RELAXED);
+  return true;
+}
+
+/**
+ * graph_ingest_end() - Stop inserting from many threads.
+ * @g: Graph to manipulate.
+ *
+ * Must not be called before every thread is done with the graph. The
+ * new nodes are put first in the node list, newest first, as if they had
+ * been inserted one by one with graph_insert_node().
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_ingest_end(graph *g)
+{
+  struct ingest *in = g->ingest;
+  int fresh = g->nextid - in->firstid;
+  node **made = malloc((fresh + 1) * sizeof(node *));
+
+  for (unsigned b = 0; b <= in->mask; b++) {
+    for (node *n = in->bucket[b]; n != NULL; n = n->hnext) {
+      if (n->id >= in->firstid) {
+        made[n->id - in->firstid] = n;
+      }
+    }
+  }
+  grow_ids(g, g->nextid);
+  for (int k = 0; k < fresh; k++) {
+    dlist_insert(g->nodes, made[k], dlist_first(g->nodes));
+    g->keys[made[k]->id] = made[k]->key;
+    g->byid[made[k]->id] = made[k];
+  }
+  free(made);
+  free(in->bucket);
+  free(in);
+  g->ingest = NULL;
+  g->version++;
+  return g;
+}
+
+// ===========BATCHED UPDATES============
+
+/*
+ * Remove the neighbours of n whose id is marked, from both the array
+ * and the list, in one pass over each. Returns the number removed.
+ */
+static int drop_marked(node *n, const bool *mark)
+{
+  int k = 0;
+  for (int i = 0; i < n->degree; i++) {
+    if (!mark[n->adj[i]->id]) {
+      n->adj[k++] = n->adj[i];
+    }
+  }
+  int dropped = n->degree - k;
+  n->degree = k;
+  dlist_pos pos = dlist_first(n->neighbours);
+  while (dropped > 0 && !dlist_is_end(n->neighbours, pos)) {
+    node *nb = dlist_inspect(n->neighbours, pos);
+    if (mark[nb->id]) {
+      // dlist_remove() returns the position after the removed element.
+      pos = dlist_remove(n->neighbours, pos);
+      continue;
+    }
+    pos = dlist_next(n->neighbours, pos);
+  }
+  return dropped;
+}
+
+/**
+ * graph_apply_ops() - Apply prepared batch operations to the graph.
+ * @g: Graph to manipulate.
+ * @ops: Edge operations, sorted by source and destination id with at
+ *       most one per edge and none on a dead node.
+ * @len: Number of edge operations.
+ * @dead: Nodes to delete, without duplicates.
+ * @deadlen: Number of nodes to delete.
+ *
+ * See graph_batch_apply(), which prepares a batch and calls this. The
+ * edge operations on one source node are applied with one pass over its
+ * neighbours for the deletes and one for the inserts, and all node
+ * deletes together with one pass over the graph, instead of one pass per
+ * operation. New edges from a node go in in order of destination id.
+ * graph_version() goes up by one.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_apply_ops(graph *g, const graph_op *ops, int len,
+  node *const *dead, int deadlen)
+{
+  bool *mark = calloc(g->nextid + 1, sizeof(bool));
+
+  for (int i = 0; i < len; ) {
+    node *n = ops[i].src;
+    int j = i;
+    while (j < len && ops[j].src == n) {
+      j++;
+    }
+    // Deletes.
+    int deletes = 0;
+    for (int k = i; k < j; k++) {
+      if (ops[k].kind == GRAPH_OP_DELETE) {
+        mark[ops[k].destid] = true;
+        deletes++;
       }
-      else {
-        printf(" YES |");
+    }
+    if (deletes > 0) {
+      g->edgecount -= drop_marked(n, mark);
+      for (int k = i; k < j; k++) {
+        mark[ops[k].destid] = false;
       }
     }
-    printf("\n");
-    for (int i = 0; i < g->nodecount + 1; i++) {
-      printf("------");
+    // Inserts, skipping edges that are already there.
+    for (int k = 0; k < n->degree; k++) {
+      mark[n->adj[k]->id] = true;
     }
-    printf("\n");
-    pos5 = dlist_next(g->nodes, pos5);
+    for (int k = i; k < j; k++) {
+      node *dest = ops[k].dest;
+      if (ops[k].kind != GRAPH_OP_INSERT || mark[dest->id]) {
+        continue;
+      }
+      if (n->degree == n->adjcap) {
+        n->adjcap = n->adjcap ? 2 * n->adjcap : 4;
+        n->adj = realloc(n->adj, n->adjcap * sizeof(node *));
+        STATS_ADD(allocs, 1);
+      }
+      n->adj[n->degree++] = dest;
+      dlist_insert(n->neighbours, dest, dlist_first(n->neighbours));
+      STATS_ADD(allocs, 1);
+      mark[dest->id] = true;
+      g->edgecount++;
+    }
+    for (int k = 0; k < n->degree; k++) {
+      mark[n->adj[k]->id] = false;
+    }
+    i = j;
   }
+
+  if (deadlen > 0) {
+    // Drop the edges into dead nodes from every live node, then the dead
+    // nodes themselves with their outgoing edges.
+    for (int k = 0; k < deadlen; k++) {
+      mark[dead[k]->id] = true;
+    }
+    dlist_pos pos = dlist_first(g->nodes);
+    while (!dlist_is_end(g->nodes, pos)) {
+      node *n = dlist_inspect(g->nodes, pos);
+      if (!mark[n->id]) {
+        g->edgecount -= drop_marked(n, mark);
+      }
+      pos = dlist_next(g->nodes, pos);
+    }
+    pos = dlist_first(g->nodes);
+    while (!dlist_is_end(g->nodes, pos)) {
+      node *n = dlist_inspect(g->nodes, pos);
+      if (mark[n->id]) {
+        g->edgecount -= n->degree;
+        drop_id(g, n);
+        dlist_kill(n->neighbours);
+        free(n->adj);
+        free(n);
+        g->nodecount--;
+        // dlist_remove() returns the position after the removed element.
+        pos = dlist_remove(g->nodes, pos);
+        continue;
+      }
+      pos = dlist_next(g->nodes, pos);
+    }
+  }
+
+  free(mark);
+  g->version++;
+  return g;
+}
+
+/**
+ * graph_version() - Return the change counter of the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A number that goes up with every change to the nodes or edges
+ * of the graph and with every graph_batch_apply(). Anything computed from
+ * the graph is still valid as long as the number is the same.
+ */
+long graph_version(const graph *g)
+{
+  return g->version;
 }
@@ -0,0 +1,749 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "stats.h"
+#include "log.h"
+
+/*
+ * Implementation of a graph in compressed sparse row form.
+ *
+ * The out-edges of all nodes live in one array adj, sorted by
+ * destination id within each node, and off[v]..off[v + 1] is the range
+ * of node v. Inserted edges go to a pending log and are merged into the
+ * arrays in one pass, O(nodes + edges), the next time the graph is read
+ * by node. Deleted edges are marked in place (stored as ~dest, which
+ * keeps the range sorted by |value|) and dropped by the next merge.
+ *
+ * Compared to graph2.c the source of an edge is implicit, so the
+ * arrays take 4 bytes per edge and 4 per node.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+struct node {
+	char name[41];
+	int id;
+	node **adj;		// Cached neighbours, see refresh().
+	int degree;
+	int adjcap;
+	dlist *neighbours;	// Made from adj by graph_neighbours().
+	int version;		// Merge version adj was built for.
+};
+
+struct pending {
+	int src;
+	int dest;
+};
+
+struct graph {
+	dlist *nodes;
+	node **byid;		// Node of each id, NULL for deleted nodes.
+	bool *seen;		// Seen flags, indexed by node id.
+	int idcap;
+	int nextid;
+	int nodecount;
+	int maxnodes;
+
+	int rows;		// Ids covered by off, the others have no edges yet.
+	int *off;		// rows + 1 offsets into adj.
+	int *adj;
+	int edgecount;		// Live edges, pending ones included.
+	int holes;		// Deleted entries still in adj.
+	struct pending *pend;
+	int npend;
+	int pendcap;
+	int version;		// Bumped by every merge.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/* The destination stored at adj[k], with the deleted mark removed. */
+static inline int dest_at(const graph *g, int k)
+{
+	return g->adj[k] >= 0 ? g->adj[k] : ~g->adj[k];
+}
+
+/*
+ * Merge the pending edges into the arrays and drop deleted and
+ * duplicate entries.
+ */
+static void merge(graph *g)
+{
+	int n = g->nextid;
+	int p = g->npend;
+	int *count = calloc(n + 1, sizeof(int));
+	struct pending *tmp = malloc((p + 1) * sizeof(struct pending));
+
+	// Sort the pending edges by (source, destination), counting sort
+	// by destination and then, stably, by source.
+	for (int k = 0; k < p; k++) {
+		count[g->pend[k].dest + 1]++;
+	}
+	for (int v = 0; v < n; v++) {
+		count[v + 1] += count[v];
+	}
+	for (int k = 0; k < p; k++) {
+		tmp[count[g->pend[k].dest]++] = g->pend[k];
+	}
+	memset(count, 0, (n + 1) * sizeof(int));
+	for (int k = 0; k < p; k++) {
+		count[tmp[k].src + 1]++;
+	}
+	for (int v = 0; v < n; v++) {
+		count[v + 1] += count[v];
+	}
+	for (int k = 0; k < p; k++) {
+		g->pend[count[tmp[k].src]++] = tmp[k];
+	}
+	free(tmp);
+	free(count);
+
+	// Merge each old row with its pending edges.
+	int *off = malloc((n + 1) * sizeof(int));
+	int *adj = malloc((g->edgecount + 1) * sizeof(int));
+	int m = 0;
+	int q = 0;
+	for (int v = 0; v < n; v++) {
+		int k = v < g->rows ? g->off[v] : 0;
+		int end = v < g->rows ? g->off[v + 1] : 0;
+		off[v] = m;
+		while (k < end || (q < p && g->pend[q].src == v)) {
+			int d;
+			if (k < end && g->adj[k] < 0) {
+				k++;
+				continue;
+			}
+			if (q < p && g->pend[q].src == v
+				&& (k == end || g->pend[q].dest < g->adj[k])) {
+				d = g->pend[q++].dest;
+			} else {
+				d = g->adj[k++];
+			}
+			if (m == off[v] || adj[m - 1] != d) {
+				adj[m++] = d;
+			}
+		}
+	}
+	off[n] = m;
+	free(g->off);
+	free(g->adj);
+	g->off = off;
+	g->adj = adj;
+	g->rows = n;
+	g->edgecount = m;
+	g->holes = 0;
+	g->npend = 0;
+	g->version++;
+	STATS_ADD(edges_scanned, m);
+	STATS_ADD(allocs, 2);
+}
+
+/*
+ * Make sure there are no pending edges, and that deleted entries do not
+ * outnumber the live ones. The graph does not change as seen through
+ * graph.h, so this is allowed on a const graph.
+ */
+static void ensure_merged(const graph *g)
+{
+	if (g->npend > 0 || g->holes > g->edgecount) {
+		merge((graph *)g);
+	}
+}
+
+/*
+ * Return the position of the entry for src -> dest in adj, deleted or
+ * not, or -1 if there is none. Pending edges are not searched.
+ */
+static int find_edge(const graph *g, int src, int dest)
+{
+	if (src >= g->rows) {
+		return -1;
+	}
+	int lo = g->off[src];
+	int hi = g->off[src + 1];
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		STATS_ADD(lookup_probes, 1);
+		if (dest_at(g, mid) < dest) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo < g->off[src + 1] && dest_at(g, lo) == dest) {
+		return lo;
+	}
+	return -1;
+}
+
+/* Make room for count neighbours in the array of n. */
+static void reserve(node *n, int count)
+{
+	if (count > n->adjcap) {
+		n->adjcap = count > 2 * n->adjcap ? count : 2 * n->adjcap;
+		n->adj = realloc(n->adj, n->adjcap * sizeof(node *));
+		STATS_ADD(allocs, 1);
+	}
+}
+
+/*
+ * Make sure the neighbour array of n is up to date with its row. A
+ * rebuilt array drops the dlist made from the old one, graph_neighbours()
+ * makes it again when asked.
+ */
+static void refresh(const graph *g, node *n)
+{
+	ensure_merged(g);
+	if (n->version == g->version) {
+		return;
+	}
+	int lo = n->id < g->rows ? g->off[n->id] : 0;
+	int hi = n->id < g->rows ? g->off[n->id + 1] : 0;
+	reserve(n, hi - lo);
+	n->degree = 0;
+	for (int k = lo; k < hi; k++) {
+		if (g->adj[k] >= 0) {
+			n->adj[n->degree++] = g->byid[g->adj[k]];
+		}
+	}
+	STATS_ADD(edges_scanned, hi - lo);
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+		n->neighbours = NULL;
+	}
+	n->version = g->version;
+}
+
+/**
+ * nodes_are_equal() - Check whether two nodes are equal.
+ * @n1: Pointer to node 1.
+ * @n2: Pointer to node 2.
+ *
+ * Returns: true if the nodes are considered equal, otherwise false.
+ *
+ */
+bool nodes_are_equal(const node *n1,const node *n2)
+{
+	return n1 == n2;
+}
+
+/**
+ * graph_empty() - Create an empty graph.
+ * @max_nodes: The maximum number of nodes the graph can hold.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty(int max_nodes)
+{
+	graph *g = malloc(sizeof(graph));
+	g->nodes = dlist_empty(NULL);
+	g->idcap = 16;
+	g->byid = malloc(g->idcap * sizeof(node *));
+	g->seen = malloc(g->idcap * sizeof(bool));
+	g->nextid = 0;
+	g->nodecount = 0;
+	g->maxnodes = max_nodes;
+	g->rows = 0;
+	g->off = calloc(1, sizeof(int));
+	g->adj = NULL;
+	g->edgecount = 0;
+	g->holes = 0;
+	g->pendcap = 16;
+	g->pend = malloc(g->pendcap * sizeof(struct pending));
+	g->npend = 0;
+	g->version = 0;
+	return g;
+}
+
+/**
+ * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
+ * @g: Graph to check.
+ *
+ * Returns: True if graph is empty, otherwise false.
+ */
+bool graph_is_empty(const graph *g)
+{
+	return dlist_is_empty(g->nodes);
+}
+
+/**
+ * graph_has_edges() - Check if a graph has any edges.
+ * @g: Graph to check.
+ *
+ * Returns: True if graph has any edges, otherwise false.
+ */
+bool graph_has_edges(const graph *g)
+{
+	return g->edgecount > 0;
+}
+
+/**
+ * graph_insert_node() - Inserts a node with the given name into the graph.
+ * @g: Graph to manipulate.
+ * @s: Node name.
+ *
+ * Creates a new node with a copy of the given name and puts it into
+ * the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_node(graph *g, const char *s)
+{
+	if (g->nodecount >= g->maxnodes) {
+		LOG_WARN("The graph is full, %s was not inserted", s);
+		return g;
+	}
+	if (graph_try_find_node(g, s) != NULL) {
+		LOG_INFO("A node with the name %s already exists in the graph", s);
+		return g;
+	}
+	if (g->nextid == g->idcap) {
+		g->idcap *= 2;
+		g->byid = realloc(g->byid, g->idcap * sizeof(node *));
+		g->seen = realloc(g->seen, g->idcap * sizeof(bool));
+	}
+
+	node *n = malloc(sizeof(node));
+	STATS_ADD(allocs, 1);
+	strncpy(n->name, s, sizeof(n->name) - 1);
+	n->name[sizeof(n->name) - 1] = '\0';
+	n->id = g->nextid++;
+	n->adj = NULL;
+	n->degree = 0;
+	n->adjcap = 0;
+	n->neighbours = NULL;
+	n->version = -1;
+	g->byid[n->id] = n;
+	g->seen[n->id] = false;
+	g->nodecount++;
+	dlist_insert(g->nodes, n, dlist_first(g->nodes));
+	return g;
+}
+
+/**
+ * graph_find_node() - Find a node stored in the graph.
+ * @g: Graph to manipulate.
+ * @s: Node identifier, e.g. a char *.
+ *
+ * Returns: A pointer to the found node. Exits the program if there is no
+ * such node, use graph_try_find_node() to check first.
+ */
+node *graph_find_node(const graph *g, const char *s)
+{
+	node *n = graph_try_find_node(g, s);
+	if (n == NULL) {
+		LOG_ERROR("There is no node with the name %s in the graph", s);
+		exit(EXIT_FAILURE);
+	}
+	return n;
+}
+
+/**
+ * graph_node_is_seen() - Return the seen status for a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph to return seen status for.
+ *
+ * Returns: The seen status for the node.
+ */
+bool graph_node_is_seen(const graph *g, const node *n)
+{
+	return g->seen[n->id];
+}
+
+/**
+ * graph_node_set_seen() - Set the seen status for a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph to set seen status for.
+ * @s: Status to set.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_node_set_seen(graph *g, node *n, bool seen)
+{
+	g->seen[n->id] = seen;
+	return g;
+}
+
+/**
+ * graph_reset_seen() - Reset the seen status on all nodes in the graph.
+ * @g: Graph to modify.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_reset_seen(graph *g)
+{
+	memset(g->seen, 0, g->nextid * sizeof(bool));
+	return g;
+}
+
+/**
+ * graph_insert_edge() - Insert an edge into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * A deleted entry for the same edge is brought back in place, otherwise
+ * the edge goes to the pending log. Duplicates among pending edges are
+ * dropped when they are merged.
+ *
+ * NOTE: Undefined unless both nodes are already in the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_edge(graph *g, node *n1, node *n2)
+{
+	int k = find_edge(g, n1->id, n2->id);
+	if (k >= 0 && g->adj[k] >= 0) {
+		LOG_INFO("Edge %s -> %s already exists", n1->name, n2->name);
+		return g;
+	}
+	if (k >= 0) {
+		g->adj[k] = n2->id;
+		g->holes--;
+	} else {
+		if (g->npend == g->pendcap) {
+			g->pendcap *= 2;
+			g->pend = realloc(g->pend, g->pendcap * sizeof(struct pending));
+			STATS_ADD(allocs, 1);
+		}
+		g->pend[g->npend].src = n1->id;
+		g->pend[g->npend].dest = n2->id;
+		g->npend++;
+	}
+	g->edgecount++;
+	n1->version = -1;
+	return g;
+}
+
+/**
+ * graph_delete_node() - Remove a node from the graph.
+ * @g: Graph to manipulate.
+ * @n: Node to remove from the graph.
+ *
+ * Returns: The modified graph.
+ *
+ * NOTE: Undefined if the node is not in the graph.
+ */
+graph *graph_delete_node(graph *g, node *n)
+{
+	ensure_merged(g);
+	for (int v = 0; v < g->rows; v++) {
+		for (int k = g->off[v]; k < g->off[v + 1]; k++) {
+			if (g->adj[k] >= 0 && (v == n->id || g->adj[k] == n->id)) {
+				g->adj[k] = ~g->adj[k];
+				g->holes++;
+				g->edgecount--;
+				if (g->byid[v] != NULL) {
+					g->byid[v]->version = -1;
+				}
+			}
+		}
+	}
+	STATS_ADD(edges_scanned, g->off[g->rows]);
+
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		if (dlist_inspect(g->nodes, pos) == n) {
+			dlist_remove(g->nodes, pos);
+			break;
+		}
+		pos = dlist_next(g->nodes, pos);
+	}
+	g->byid[n->id] = NULL;
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+	}
+	free(n->adj);
+	free(n);
+	g->nodecount--;
+	return g;
+}
+
+/**
+ * graph_delete_edge() - Remove an edge from the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ *
+ * NOTE: Undefined if the edge is not in the graph.
+ */
+graph *graph_delete_edge(graph *g, node *n1, node *n2)
+{
+	if (g->npend > 0) {
+		merge(g);
+	}
+	int k = find_edge(g, n1->id, n2->id);
+	if (k >= 0 && g->adj[k] >= 0) {
+		g->adj[k] = ~g->adj[k];
+		g->holes++;
+		g->edgecount--;
+		n1->version = -1;
+	}
+	return g;
+}
+
+/**
+ * graph_choose_node() - Return an arbitrary node from the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to an arbitrary node.
+ *
+ * NOTE: The return value is undefined for an empty graph.
+ */
+node *graph_choose_node(const graph *g)
+{
+	return dlist_inspect(g->nodes, dlist_first(g->nodes));
+}
+
+/**
+ * graph_neighbours() - Return a list of neighbour nodes.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ *
+ * The list is made from the neighbour array of the node and cached in
+ * the node until its edges change. graph_neighbours_span() avoids the
+ * list altogether.
+ *
+ * Returns: A pointer to a list of nodes, in id order. Note: The list is
+ * owned by the graph and must not be modified or dlist_kill()-ed.
+ */
+dlist *graph_neighbours(const graph *g,const node *n)
+{
+	// Only the caches in the node change.
+	node *mn = (node *)n;
+	refresh(g, mn);
+	if (mn->neighbours == NULL) {
+		mn->neighbours = dlist_empty(NULL);
+		dlist_pos pos = dlist_first(mn->neighbours);
+		for (int k = 0; k < mn->degree; k++) {
+			pos = dlist_insert(mn->neighbours, mn->adj[k], pos);
+			pos = dlist_next(mn->neighbours, pos);
+		}
+		STATS_ADD(allocs, 1 + mn->degree);
+	}
+	return mn->neighbours;
+}
+
+/**
+ * graph_kill() - Destroy a given graph.
+ * @g: Graph to destroy.
+ *
+ * Return all dynamic memory used by the graph.
+ *
+ * Returns: Nothing.
+ */
+void graph_kill(graph *g)
+{
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		node *n = dlist_inspect(g->nodes, pos);
+		pos = dlist_next(g->nodes, pos);
+		if (n->neighbours != NULL) {
+			dlist_kill(n->neighbours);
+		}
+		free(n->adj);
+		free(n);
+	}
+	dlist_kill(g->nodes);
+	free(g->byid);
+	free(g->seen);
+	free(g->off);
+	free(g->adj);
+	free(g->pend);
+	free(g);
+}
+
+/**
+ * graph_print() - Iterate over the graph elements and print their values.
+ * @g: Graph to inspect.
+ *
+ * Prints the number of nodes and edges followed by one "SRC DEST" line
+ * per edge, in source id order.
+ *
+ * Returns: Nothing.
+ */
+void graph_print(const graph *g)
+{
+	ensure_merged(g);
+	printf("%d nodes, %d edges\n", g->nodecount, g->edgecount);
+	for (int v = 0; v < g->rows; v++) {
+		for (int k = g->off[v]; k < g->off[v + 1]; k++) {
+			if (g->adj[k] >= 0) {
+				printf("%s %s\n", g->byid[v]->name, g->byid[g->adj[k]]->name);
+			}
+		}
+	}
+}
+
+// ===========EXTENDED INTERFACE (graph_ext.h)============
+
+/**
+ * graph_nodecount() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_nodecount(const graph *g)
+{
+	return g->nodecount;
+}
+
+/**
+ * graph_edgecount() - Return the number of edges in the graph.
+ * @g: Graph to inspect.
+ *
+ * Pending duplicates are only dropped when merged, so this merges the
+ * pending edges if there are any.
+ *
+ * Returns: The number of edges.
+ */
+int graph_edgecount(const graph *g)
+{
+	ensure_merged(g);
+	return g->edgecount;
+}
+
+/**
+ * graph_id_bound() - Return an upper bound on the node ids in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A value larger than every id handed out by graph_node_id().
+ */
+int graph_id_bound(const graph *g)
+{
+	return g->nextid;
+}
+
+/**
+ * graph_node_id() - Return the id of a node.
+ * @n: Node to inspect.
+ *
+ * Ids are handed out in insertion order and never reused, so they stay
+ * valid for as long as the node is in the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const node *n)
+{
+	return n->id;
+}
+
+/**
+ * graph_node_name() - Return the name of a node.
+ * @n: Node to inspect.
+ *
+ * Returns: A pointer to the name stored in the node.
+ */
+const char *graph_node_name(const node *n)
+{
+	return n->name;
+}
+
+/**
+ * graph_nodes() - Return the list of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the internal list of nodes. Note: The list is
+ * owned by the graph and must not be modified or dlist_kill()-ed.
+ */
+dlist *graph_nodes(const graph *g)
+{
+	return g->nodes;
+}
+
+/**
+ * graph_try_find_node() - Find a node stored in the graph.
+ * @g: Graph to inspect.
+ * @s: Node name.
+ *
+ * Returns: A pointer to the found node, or NULL if there is no node with
+ * the given name.
+ */
+node *graph_try_find_node(const graph *g, const char *s)
+{
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		node *n = dlist_inspect(g->nodes, pos);
+		STATS_ADD(lookup_probes, 1);
+		if (!strcmp(n->name, s)) {
+			return n;
+		}
+		pos = dlist_next(g->nodes, pos);
+	}
+	return NULL;
+}
+
+/**
+ * graph_find_nodes() - Find many nodes stored in the graph.
+ * @g: Graph to inspect.
+ * @names: Node names to look up.
+ * @count: Number of names.
+ * @out: Array of count pointers to store the found nodes in. Names
+ *       that are not in the graph get NULL.
+ *
+ * Returns: The number of names that were found.
+ */
+int graph_find_nodes(const graph *g, const char **names, int count, node **out)
+{
+	int found = 0;
+	for (int k = 0; k < count; k++) {
+		out[k] = graph_try_find_node(g, names[k]);
+		if (out[k] != NULL) {
+			found++;
+		}
+	}
+	return found;
+}
+
+/**
+ * graph_edges() - Copy out all edges of the graph.
+ * @g: Graph to inspect.
+ * @src: Array of graph_edgecount() entries for the source node ids.
+ * @dest: Array of graph_edgecount() entries for the destination node ids.
+ *
+ * The edges come out sorted by source and then destination id.
+ *
+ * Returns: The number of edges copied.
+ */
+int graph_edges(const graph *g, int *src, int *dest)
+{
+	int m = 0;
+	ensure_merged(g);
+	for (int v = 0; v < g->rows; v++) {
+		for (int k = g->off[v]; k < g->off[v + 1]; k++) {
+			if (g->adj[k] >= 0) {
+				src[m] = v;
+				dest[m] = g->adj[k];
+				m++;
+			}
+		}
+	}
+	STATS_ADD(edges_scanned, m);
+	return m;
+}
+
+/**
+ * graph_neighbours_span() - Return the neighbours of a node as an array.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @count: Where to store the number of neighbours.
+ *
+ * Returns: A pointer to the *count neighbours, in id order. Note: The
+ * array is owned by the graph and is only valid until the next change
+ * to the edges of the graph.
+ */
+node *const *graph_neighbours_span(const graph *g, const node *n, int *count)
+{
+	node *mn = (node *)n;
+	refresh(g, mn);
+	*count = mn->degree;
+	return mn->adj;
+}
@@ -0,0 +1,40 @@
+#ifndef __GRAPH_EXT_H
+#define __GRAPH_EXT_H
+
+#include "graph.h"
+
+/*
+ * Extensions to the graph interface in graph.h. Gives the modules that
+ * build derived structures (compact copies, indexes) access to node
+ * names, stable node ids and the node list, and lookups that report a
+ * missing name instead of exiting, a copy of all edges for edge-centric
+ * scans and the neighbours of a node as a plain array. Implemented by
+ * graph4.c, graph2.c, graph_csr.c and graph_matrix.c.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+int graph_nodecount(const graph *g);
+int graph_edgecount(const graph *g);
+int graph_id_bound(const graph *g);
+int graph_node_id(const node *n);
+const char *graph_node_name(const node *n);
+dlist *graph_nodes(const graph *g);
+node *graph_try_find_node(const graph *g, const char *s);
+int graph_find_nodes(const graph *g, const char **names, int count, node **out);
+int graph_edges(const graph *g, int *src, int *dest);
+node *const *graph_neighbours_span(const graph *g, const node *n, int *count);
+
+/*
+ * Loop over the neighbours of node n in graph g, with nb set to each in
+ * turn. Uses graph_neighbours_span(), so the body must not insert or
+ * delete edges from n. break works as in a plain for loop.
+ */
+#define GRAPH_FOR_EACH_NEIGHBOUR(g, n, nb) \
+	for (int nb##_count, nb##_once = 1; nb##_once; nb##_once = 0) \
+		for (node *nb, *const *nb##_p = graph_neighbours_span(g, n, &nb##_count), \
+			*const *nb##_end = nb##_p + nb##_count; \
+			nb##_p < nb##_end && (nb = *nb##_p, 1); nb##_p++)
+
+#endif
@@ -0,0 +1,640 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "stats.h"
+#include "log.h"
+
+/*
+ * Implementation of a graph as a bit-packed adjacency matrix.
+ *
+ * Row v holds one bit per node id, set if there is an edge from v to
+ * that node, packed 64 to a word. Inserting, deleting and testing an
+ * edge is a single bit operation, and the neighbours of a node are
+ * found a word at a time. The matrix takes (ids^2)/8 bytes, so this
+ * suits small dense graphs of up to a few thousand nodes. It is grown
+ * by doubling as ids are handed out, not sized by max_nodes up front.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef unsigned long long word;
+
+#define WORD_BITS 64
+
+// ===========INTERNAL DATA TYPES============
+
+struct node {
+	char name[41];
+	int id;
+	node **adj;		// Cached neighbours, see refresh().
+	int degree;
+	int adjcap;
+	dlist *neighbours;	// Made from adj by graph_neighbours().
+	bool fresh;		// adj matches the row.
+};
+
+struct graph {
+	dlist *nodes;
+	node **byid;		// Node of each id, NULL for deleted nodes.
+	bool *seen;		// Seen flags, indexed by node id.
+	int nextid;
+	int nodecount;
+	int maxnodes;
+	int edgecount;
+
+	int cap;		// Rows in the matrix, a multiple of WORD_BITS.
+	int stride;		// Words per row, cap / WORD_BITS.
+	word *bits;		// cap rows of stride words.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/* The row of id v. */
+static inline word *row(const graph *g, int v)
+{
+	return g->bits + (size_t)v * g->stride;
+}
+
+static inline bool test_bit(const word *r, int v)
+{
+	return (r[v / WORD_BITS] >> (v % WORD_BITS)) & 1;
+}
+
+/*
+ * Double the size of the matrix until id v fits. The rows are copied
+ * into the new matrix, which also has room for more columns.
+ */
+static void grow(graph *g, int v)
+{
+	int cap = g->cap;
+	while (cap <= v) {
+		cap *= 2;
+	}
+	int stride = cap / WORD_BITS;
+	word *bits = calloc((size_t)cap * stride, sizeof(word));
+	for (int u = 0; u < g->cap; u++) {
+		memcpy(bits + (size_t)u * stride, row(g, u), g->stride * sizeof(word));
+	}
+	free(g->bits);
+	g->bits = bits;
+	g->byid = realloc(g->byid, cap * sizeof(node *));
+	g->seen = realloc(g->seen, cap * sizeof(bool));
+	g->cap = cap;
+	g->stride = stride;
+	STATS_ADD(allocs, 3);
+}
+
+/* Make room for count neighbours in the array of n. */
+static void reserve(node *n, int count)
+{
+	if (count > n->adjcap) {
+		n->adjcap = count > 2 * n->adjcap ? count : 2 * n->adjcap;
+		n->adj = realloc(n->adj, n->adjcap * sizeof(node *));
+		STATS_ADD(allocs, 1);
+	}
+}
+
+/*
+ * Make sure the neighbour array of n is up to date with its row. The
+ * row is read a word at a time, skipping empty words. A rebuilt array
+ * drops the dlist made from the old one, graph_neighbours() makes it
+ * again when asked.
+ */
+static void refresh(const graph *g, node *n)
+{
+	if (n->fresh) {
+		return;
+	}
+	const word *r = row(g, n->id);
+	int count = 0;
+	for (int w = 0; w < g->stride; w++) {
+		count += __builtin_popcountll(r[w]);
+	}
+	reserve(n, count);
+	n->degree = 0;
+	for (int w = 0; w < g->stride; w++) {
+		for (word bits = r[w]; bits != 0; bits &= bits - 1) {
+			n->adj[n->degree++] = g->byid[w * WORD_BITS + __builtin_ctzll(bits)];
+		}
+	}
+	STATS_ADD(edges_scanned, g->stride);
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+		n->neighbours = NULL;
+	}
+	n->fresh = true;
+}
+
+/**
+ * nodes_are_equal() - Check whether two nodes are equal.
+ * @n1: Pointer to node 1.
+ * @n2: Pointer to node 2.
+ *
+ * Returns: true if the nodes are considered equal, otherwise false.
+ *
+ */
+bool nodes_are_equal(const node *n1,const node *n2)
+{
+	return n1 == n2;
+}
+
+/**
+ * graph_empty() - Create an empty graph.
+ * @max_nodes: The maximum number of nodes the graph can hold.
+ *
+ * Returns: A pointer to the new graph.
+ */
+graph *graph_empty(int max_nodes)
+{
+	graph *g = malloc(sizeof(graph));
+	g->nodes = dlist_empty(NULL);
+	g->nextid = 0;
+	g->nodecount = 0;
+	g->maxnodes = max_nodes;
+	g->edgecount = 0;
+	g->cap = WORD_BITS;
+	g->stride = 1;
+	g->bits = calloc(g->cap, sizeof(word));
+	g->byid = malloc(g->cap * sizeof(node *));
+	g->seen = malloc(g->cap * sizeof(bool));
+	return g;
+}
+
+/**
+ * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
+ * @g: Graph to check.
+ *
+ * Returns: True if graph is empty, otherwise false.
+ */
+bool graph_is_empty(const graph *g)
+{
+	return dlist_is_empty(g->nodes);
+}
+
+/**
+ * graph_has_edges() - Check if a graph has any edges.
+ * @g: Graph to check.
+ *
+ * Returns: True if graph has any edges, otherwise false.
+ */
+bool graph_has_edges(const graph *g)
+{
+	return g->edgecount > 0;
+}
+
+/**
+ * graph_insert_node() - Inserts a node with the given name into the graph.
+ * @g: Graph to manipulate.
+ * @s: Node name.
+ *
+ * Creates a new node with a copy of the given name and puts it into
+ * the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_node(graph *g, const char *s)
+{
+	if (g->nodecount >= g->maxnodes) {
+		LOG_WARN("The graph is full, %s was not inserted", s);
+		return g;
+	}
+	if (graph_try_find_node(g, s) != NULL) {
+		LOG_INFO("A node with the name %s already exists in the graph", s);
+		return g;
+	}
+	if (g->nextid == g->cap) {
+		grow(g, g->nextid);
+	}
+
+	node *n = malloc(sizeof(node));
+	STATS_ADD(allocs, 1);
+	strncpy(n->name, s, sizeof(n->name) - 1);
+	n->name[sizeof(n->name) - 1] = '\0';
+	n->id = g->nextid++;
+	n->adj = NULL;
+	n->degree = 0;
+	n->adjcap = 0;
+	n->neighbours = NULL;
+	n->fresh = false;
+	g->byid[n->id] = n;
+	g->seen[n->id] = false;
+	g->nodecount++;
+	dlist_insert(g->nodes, n, dlist_first(g->nodes));
+	return g;
+}
+
+/**
+ * graph_find_node() - Find a node stored in the graph.
+ * @g: Graph to manipulate.
+ * @s: Node identifier, e.g. a char *.
+ *
+ * Returns: A pointer to the found node. Exits the program if there is no
+ * such node, use graph_try_find_node() to check first.
+ */
+node *graph_find_node(const graph *g, const char *s)
+{
+	node *n = graph_try_find_node(g, s);
+	if (n == NULL) {
+		LOG_ERROR("There is no node with the name %s in the graph", s);
+		exit(EXIT_FAILURE);
+	}
+	return n;
+}
+
+/**
+ * graph_node_is_seen() - Return the seen status for a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph to return seen status for.
+ *
+ * Returns: The seen status for the node.
+ */
+bool graph_node_is_seen(const graph *g, const node *n)
+{
+	return g->seen[n->id];
+}
+
+/**
+ * graph_node_set_seen() - Set the seen status for a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph to set seen status for.
+ * @s: Status to set.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_node_set_seen(graph *g, node *n, bool seen)
+{
+	g->seen[n->id] = seen;
+	return g;
+}
+
+/**
+ * graph_reset_seen() - Reset the seen status on all nodes in the graph.
+ * @g: Graph to modify.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_reset_seen(graph *g)
+{
+	memset(g->seen, 0, g->nextid * sizeof(bool));
+	return g;
+}
+
+/**
+ * graph_insert_edge() - Insert an edge into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * NOTE: Undefined unless both nodes are already in the graph.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_edge(graph *g, node *n1, node *n2)
+{
+	word *r = row(g, n1->id);
+	word bit = (word)1 << (n2->id % WORD_BITS);
+	if (r[n2->id / WORD_BITS] & bit) {
+		LOG_INFO("Edge %s -> %s already exists", n1->name, n2->name);
+		return g;
+	}
+	r[n2->id / WORD_BITS] |= bit;
+	g->edgecount++;
+	n1->fresh = false;
+	return g;
+}
+
+/**
+ * graph_delete_node() - Remove a node from the graph.
+ * @g: Graph to manipulate.
+ * @n: Node to remove from the graph.
+ *
+ * Clears the row and the column of the node.
+ *
+ * Returns: The modified graph.
+ *
+ * NOTE: Undefined if the node is not in the graph.
+ */
+graph *graph_delete_node(graph *g, node *n)
+{
+	word *r = row(g, n->id);
+	for (int w = 0; w < g->stride; w++) {
+		g->edgecount -= __builtin_popcountll(r[w]);
+		r[w] = 0;
+	}
+	int w = n->id / WORD_BITS;
+	word bit = (word)1 << (n->id % WORD_BITS);
+	for (int v = 0; v < g->nextid; v++) {
+		if (row(g, v)[w] & bit) {
+			row(g, v)[w] &= ~bit;
+			g->edgecount--;
+			g->byid[v]->fresh = false;
+		}
+	}
+
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		if (dlist_inspect(g->nodes, pos) == n) {
+			dlist_remove(g->nodes, pos);
+			break;
+		}
+		pos = dlist_next(g->nodes, pos);
+	}
+	g->byid[n->id] = NULL;
+	if (n->neighbours != NULL) {
+		dlist_kill(n->neighbours);
+	}
+	free(n->adj);
+	free(n);
+	g->nodecount--;
+	return g;
+}
+
+/**
+ * graph_delete_edge() - Remove an edge from the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ *
+ * NOTE: Undefined if the edge is not in the graph.
+ */
+graph *graph_delete_edge(graph *g, node *n1, node *n2)
+{
+	word *r = row(g, n1->id);
+	word bit = (word)1 << (n2->id % WORD_BITS);
+	if (r[n2->id / WORD_BITS] & bit) {
+		r[n2->id / WORD_BITS] &= ~bit;
+		g->edgecount--;
+		n1->fresh = false;
+	}
+	return g;
+}
+
+/**
+ * graph_choose_node() - Return an arbitrary node from the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to an arbitrary node.
+ *
+ * NOTE: The return value is undefined for an empty graph.
+ */
+node *graph_choose_node(const graph *g)
+{
+	return dlist_inspect(g->nodes, dlist_first(g->nodes));
+}
+
+/**
+ * graph_neighbours() - Return a list of neighbour nodes.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ *
+ * The list is made from the neighbour array of the node and cached in
+ * the node until its row changes. graph_neighbours_span() avoids the
+ * list altogether.
+ *
+ * Returns: A pointer to a list of nodes, in id order. Note: The list is
+ * owned by the graph and must not be modified or dlist_kill()-ed.
+ */
+dlist *graph_neighbours(const graph *g,const node *n)
+{
+	// Only the caches in the node change.
+	node *mn = (node *)n;
+	refresh(g, mn);
+	if (mn->neighbours == NULL) {
+		mn->neighbours = dlist_empty(NULL);
+		dlist_pos pos = dlist_first(mn->neighbours);
+		for (int k = 0; k < mn->degree; k++) {
+			pos = dlist_insert(mn->neighbours, mn->adj[k], pos);
+			pos = dlist_next(mn->neighbours, pos);
+		}
+		STATS_ADD(allocs, 1 + mn->degree);
+	}
+	return mn->neighbours;
+}
+
+/**
+ * graph_kill() - Destroy a given graph.
+ * @g: Graph to destroy.
+ *
+ * Return all dynamic memory used by the graph.
+ *
+ * Returns: Nothing.
+ */
+void graph_kill(graph *g)
+{
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		node *n = dlist_inspect(g->nodes, pos);
+		pos = dlist_next(g->nodes, pos);
+		if (n->neighbours != NULL) {
+			dlist_kill(n->neighbours);
+		}
+		free(n->adj);
+		free(n);
+	}
+	dlist_kill(g->nodes);
+	free(g->bits);
+	free(g->byid);
+	free(g->seen);
+	free(g);
+}
+
+/**
+ * graph_print() - Iterate over the graph elements and print their values.
+ * @g: Graph to inspect.
+ *
+ * Prints the matrix straight from the bits: one row per node, with YES
+ * in the column of every node it has an edge to. Rows and columns are
+ * in id order.
+ *
+ * Returns: Nothing.
+ */
+void graph_print(const graph *g)
+{
+	printf("\n     |");
+	for (int v = 0; v < g->nextid; v++) {
+		if (g->byid[v] != NULL) {
+			printf(" %s |", g->byid[v]->name);
+		}
+	}
+	printf("\n");
+	for (int u = 0; u < g->nextid; u++) {
+		if (g->byid[u] == NULL) {
+			continue;
+		}
+		const word *r = row(g, u);
+		printf(" %s |", g->byid[u]->name);
+		for (int v = 0; v < g->nextid; v++) {
+			if (g->byid[v] != NULL) {
+				printf(test_bit(r, v) ? " YES |" : " NON |");
+			}
+		}
+		printf("\n");
+	}
+}
+
+// ===========EXTENDED INTERFACE (graph_ext.h)============
+
+/**
+ * graph_nodecount() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes.
+ */
+int graph_nodecount(const graph *g)
+{
+	return g->nodecount;
+}
+
+/**
+ * graph_edgecount() - Return the number of edges in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of edges.
+ */
+int graph_edgecount(const graph *g)
+{
+	return g->edgecount;
+}
+
+/**
+ * graph_id_bound() - Return an upper bound on the node ids in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A value larger than every id handed out by graph_node_id().
+ */
+int graph_id_bound(const graph *g)
+{
+	return g->nextid;
+}
+
+/**
+ * graph_node_id() - Return the id of a node.
+ * @n: Node to inspect.
+ *
+ * Ids are handed out in insertion order and never reused, so they stay
+ * valid for as long as the node is in the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const node *n)
+{
+	return n->id;
+}
+
+/**
+ * graph_node_name() - Return the name of a node.
+ * @n: Node to inspect.
+ *
+ * Returns: A pointer to the name stored in the node.
+ */
+const char *graph_node_name(const node *n)
+{
+	return n->name;
+}
+
+/**
+ * graph_nodes() - Return the list of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the internal list of nodes. Note: The list is
+ * owned by the graph and must not be modified or dlist_kill()-ed.
+ */
+dlist *graph_nodes(const graph *g)
+{
+	return g->nodes;
+}
+
+/**
+ * graph_try_find_node() - Find a node stored in the graph.
+ * @g: Graph to inspect.
+ * @s: Node name.
+ *
+ * Returns: A pointer to the found node, or NULL if there is no node with
+ * the given name.
+ */
+node *graph_try_find_node(const graph *g, const char *s)
+{
+	dlist_pos pos = dlist_first(g->nodes);
+	while (!dlist_is_end(g->nodes, pos)) {
+		node *n = dlist_inspect(g->nodes, pos);
+		STATS_ADD(lookup_probes, 1);
+		if (!strcmp(n->name, s)) {
+			return n;
+		}
+		pos = dlist_next(g->nodes, pos);
+	}
+	return NULL;
+}
+
+/**
+ * graph_find_nodes() - Find many nodes stored in the graph.
+ * @g: Graph to inspect.
+ * @names: Node names to look up.
+ * @count: Number of names.
+ * @out: Array of count pointers to store the found nodes in. Names
+ *       that are not in the graph get NULL.
+ *
+ * Returns: The number of names that were found.
+ */
+int graph_find_nodes(const graph *g, const char **names, int count, node **out)
+{
+	int found = 0;
+	for (int k = 0; k < count; k++) {
+		out[k] = graph_try_find_node(g, names[k]);
+		if (out[k] != NULL) {
+			found++;
+		}
+	}
+	return found;
+}
+
+/**
+ * graph_edges() - Copy out all edges of the graph.
+ * @g: Graph to inspect.
+ * @src: Array of graph_edgecount() entries for the source node ids.
+ * @dest: Array of graph_edgecount() entries for the destination node ids.
+ *
+ * The edges come out sorted by source and then destination id.
+ *
+ * Returns: The number of edges copied.
+ */
+int graph_edges(const graph *g, int *src, int *dest)
+{
+	int m = 0;
+	for (int u = 0; u < g->nextid; u++) {
+		const word *r = row(g, u);
+		for (int w = 0; w < g->stride; w++) {
+			for (word bits = r[w]; bits != 0; bits &= bits - 1) {
+				src[m] = u;
+				dest[m] = w * WORD_BITS + __builtin_ctzll(bits);
+				m++;
+			}
+		}
+	}
+	STATS_ADD(edges_scanned, (long)g->nextid * g->stride);
+	return m;
+}
+
+/**
+ * graph_neighbours_span() - Return the neighbours of a node as an array.
+ * @g: Graph to inspect.
+ * @n: Node to get neighbours for.
+ * @count: Where to store the number of neighbours.
+ *
+ * Returns: A pointer to the *count neighbours, in id order. Note: The
+ * array is owned by the graph and is only valid until the next change
+ * to the edges of the graph.
+ */
+node *const *graph_neighbours_span(const graph *g, const node *n, int *count)
+{
+	node *mn = (node *)n;
+	refresh(g, mn);
+	*count = mn->degree;
+	return mn->adj;
+}
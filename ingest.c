@@ -0,0 +1,232 @@
+#include <ctype.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "ingest.h"
+
+/*
+ * Parallel map file loader on top of the ingest functions in graph4.c.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define BUFSIZE 300
+#define NAMELEN 40
+
+/* One slice of the edge lines and what became of it. */
+struct slice {
+	graph *g;
+	const char *begin;
+	const char *end;
+	int lines;	// Lines parsed, up to and including a bad one.
+	int edges;	// Edge lines among them.
+	int dropped;	// Edges left out because the graph was full.
+	int first_dropped;	// Line of the first of them within the slice.
+	bool bad;
+};
+
+/*
+ * Copy the line starting at p, up to end, into buf as fgets() with a
+ * buffer of BUFSIZE would. Returns the start of the next line.
+ */
+static const char *next_line(const char *p, const char *end, char *buf)
+{
+	const char *nl = memchr(p, '\n', end - p);
+	const char *stop = nl != NULL ? nl + 1 : end;
+	size_t len = stop - p;
+
+	if (len > BUFSIZE - 1) {
+		len = BUFSIZE - 1;
+	}
+	memcpy(buf, p, len);
+	buf[len] = '\0';
+	return stop;
+}
+
+/* Return true if s is blank or a comment line. */
+static bool line_is_ignored(const char *s)
+{
+	while (*s && isspace((unsigned char)*s)) {
+		s++;
+	}
+	return *s == '\0' || *s == '#';
+}
+
+static void *load_slice(void *arg)
+{
+	struct slice *sl = arg;
+	char line[BUFSIZE];
+	char srcstr[NAMELEN + 1];
+	char deststr[NAMELEN + 1];
+
+	for (const char *p = sl->begin; p < sl->end; ) {
+		p = next_line(p, sl->end, line);
+		sl->lines++;
+		if (line_is_ignored(line)) {
+			continue;
+		}
+		if (sscanf(line, "%40s %40s", srcstr, deststr) != 2) {
+			sl->bad = true;
+			return NULL;
+		}
+		sl->edges++;
+		node *n1 = graph_ingest_node(sl->g, srcstr);
+		node *n2 = graph_ingest_node(sl->g, deststr);
+		if (n1 != NULL && n2 != NULL) {
+			graph_ingest_edge(sl->g, n1, n2);
+		} else if (sl->dropped++ == 0) {
+			sl->first_dropped = sl->lines;
+		}
+	}
+	return NULL;
+}
+
+/* Return the line within sl, counted from 1, of its k-th edge line. */
+static int edge_line(const struct slice *sl, int k)
+{
+	char line[BUFSIZE];
+	int lines = 0;
+
+	for (const char *p = sl->begin; p < sl->end && k > 0; ) {
+		p = next_line(p, sl->end, line);
+		lines++;
+		if (!line_is_ignored(line)) {
+			k--;
+		}
+	}
+	return lines;
+}
+
+/* Read all of in. Returns the text, or NULL on a read error. */
+static char *read_all(FILE *in, size_t *len)
+{
+	size_t cap = 1 << 16;
+	char *text = malloc(cap);
+
+	*len = 0;
+	for (;;) {
+		*len += fread(text + *len, 1, cap - *len, in);
+		if (*len < cap) {
+			break;
+		}
+		cap *= 2;
+		text = realloc(text, cap);
+	}
+	if (ferror(in)) {
+		free(text);
+		return NULL;
+	}
+	return text;
+}
+
+/**
+ * ingest_map() - Read a map file into a new graph using many threads.
+ * @in: Map file, read to its end.
+ * @file_name: Name of the file, for error messages.
+ * @nthreads: Number of threads to parse and insert the edges with.
+ *
+ * The file is read into memory and the edge lines after the line with
+ * the number of edges are cut into nthreads slices at line breaks. Each
+ * thread inserts the edges of its slice through graph_ingest_node() and
+ * graph_ingest_edge(). The resulting graph has the same nodes and edges
+ * as one read line by line, but the node ids and the order of the node
+ * list and of the neighbours depend on how the threads were scheduled.
+ *
+ * Returns: The new graph, or NULL after printing a message to stderr if
+ * the file could not be read or is malformed.
+ */
+graph *ingest_map(FILE *in, const char *file_name, int nthreads)
+{
+	char line[BUFSIZE];
+	size_t len;
+	char *text = read_all(in, &len);
+	if (text == NULL) {
+		fprintf(stderr, "%s: read error\n", file_name);
+		return NULL;
+	}
+	const char *end = text + len;
+
+	// Find the number of edges.
+	const char *p = text;
+	int edges = -1;
+	int lineno = 0;
+	while (edges < 0 && p < end) {
+		p = next_line(p, end, line);
+		lineno++;
+		if (line_is_ignored(line)) {
+			continue;
+		}
+		if (sscanf(line, "%d", &edges) != 1 || edges < 0) {
+			fprintf(stderr, "%s:%d: expected number of edges\n",
+				file_name, lineno);
+			free(text);
+			return NULL;
+		}
+	}
+	if (edges < 0) {
+		fprintf(stderr, "%s: no number of edges found\n", file_name);
+		free(text);
+		return NULL;
+	}
+
+	// Every edge brings at most two new nodes.
+	graph *g = graph_ingest_begin(graph_empty(2 * edges + 1));
+	if (nthreads < 1) {
+		nthreads = 1;
+	}
+	struct slice *sl = calloc(nthreads, sizeof(struct slice));
+	pthread_t *threads = malloc(nthreads * sizeof(pthread_t));
+	size_t step = (end - p) / nthreads + 1;
+	for (int k = 0; k < nthreads; k++) {
+		sl[k].g = g;
+		sl[k].begin = k == 0 ? p : sl[k - 1].end;
+		sl[k].end = sl[k].begin;
+		if (sl[k].begin < end) {
+			// Cut after the first line break past the even share.
+			const char *cut = end - sl[k].begin > (ptrdiff_t)step
+				? sl[k].begin + step : end;
+			const char *nl = memchr(cut, '\n', end - cut);
+			sl[k].end = nl != NULL && k < nthreads - 1 ? nl + 1 : end;
+		}
+		pthread_create(&threads[k], NULL, load_slice, &sl[k]);
+	}
+	for (int k = 0; k < nthreads; k++) {
+		pthread_join(threads[k], NULL);
+	}
+	g = graph_ingest_end(g);
+
+	for (int k = 0, seen = 0; k < nthreads; k++) {
+		if (seen + sl[k].edges > edges) {
+			fprintf(stderr, "%s:%d: more edges than declared\n", file_name,
+				lineno + edge_line(&sl[k], edges - seen + 1));
+			graph_kill(g);
+			g = NULL;
+			break;
+		}
+		seen += sl[k].edges;
+		// The graph only has room for the nodes of the declared edges.
+		if (sl[k].dropped > 0) {
+			fprintf(stderr, "%s:%d: too many nodes\n", file_name,
+				lineno + sl[k].first_dropped);
+			graph_kill(g);
+			g = NULL;
+			break;
+		}
+		lineno += sl[k].lines;
+		if (sl[k].bad) {
+			fprintf(stderr, "%s:%d: expected an edge\n", file_name, lineno);
+			graph_kill(g);
+			g = NULL;
+			break;
+		}
+	}
+	free(threads);
+	free(sl);
+	free(text);
+	return g;
+}
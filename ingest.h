@@ -0,0 +1,33 @@
+#ifndef __INGEST_H
+#define __INGEST_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "graph.h"
+
+/*
+ * Building a graph from many threads at once.
+ *
+ * graph_ingest_begin() puts a graph into ingest mode. Until
+ * graph_ingest_end(), producer threads may call graph_ingest_node() and
+ * graph_ingest_edge() concurrently: names are looked up in a hash table
+ * whose buckets are guarded by striped spin locks, the edges from a node
+ * are guarded by the stripe of its id, and the node and edge counters
+ * are updated atomically. These four are implemented by graph4.c only.
+ *
+ * ingest_map() reads a map file (see is_connected.c) with nthreads
+ * threads, each parsing and inserting its own slice of the lines.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+graph *graph_ingest_begin(graph *g);
+node *graph_ingest_node(graph *g, const char *s);
+bool graph_ingest_edge(graph *g, node *n1, node *n2);
+graph *graph_ingest_end(graph *g);
+
+graph *ingest_map(FILE *in, const char *file_name, int nthreads);
+
+#endif
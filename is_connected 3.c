@@ -3,35 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "graph.h"
-#include "queue.h"
-//gcc -std=c99 -Wall -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o is_connected is_connected.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/list/list.c
-bool find_path(graph *g, node *src, node *dest) {
-  queue *q = queue_empty(NULL);
-  g = graph_node_set_seen(g, src, true);
-  q = queue_enqueue(q, src);
-  printf("Hej");
-  while (!queue_is_empty(q)) {
-    node *n = queue_front(q);
-    q = queue_dequeue(q);
-    dlist *neighbourSet = graph_neighbours(g, n);
-  	dlist_pos pos = dlist_first(neighbourSet);
-  	while (!dlist_is_end(neighbourSet, pos)) {
-  		node *entry = dlist_inspect(neighbourSet, pos);
-  		pos = dlist_next(neighbourSet, pos);
-      if (!graph_node_is_seen(g, entry)) {
-        g = graph_node_set_seen(g, entry, true);
-        q = queue_enqueue(q, entry);
-      }
-  	}
-  }
-  if (graph_node_is_seen(g, dest)) {
-    return true;
-  }
-  else {
-    return false;
-  }
-}
-
+#include "graph_ext.h"
+#include "path.h"
+//gcc -std=c99 -Wall -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o is_connected is_connected.c path.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/list/list.c
 void user_interaction(const graph *g, char *srcstr, char *deststr)
 {
   char instr[82];
@@ -68,7 +42,12 @@ int main(int argc, char const *argv[]) {
   char srcstr[41];
   char deststr[41];
   user_interaction(g, srcstr, deststr);
-  if (find_path(g, graph_find_node(g, srcstr), graph_find_node(g,deststr))) {
+  node *src = graph_try_find_node(g, srcstr);
+  node *dest = graph_try_find_node(g, deststr);
+  if (src == NULL || dest == NULL) {
+    printf("Unknown airport %s", src == NULL ? srcstr : deststr);
+  }
+  else if (find_path(g, src, dest)) {
     printf("There is a path from %s to %s", srcstr, deststr);
   }
   else {
@@ -1,10 +1,66 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h> // For bool
 #include <ctype.h> // For isspace(), etc.
 #include <errno.h> // For better error messages
+#include <limits.h> // For INT_MAX
+#include <signal.h> // For ignoring SIGPIPE
+#include <unistd.h> // For read(), close(), unlink()
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "cgraph.h"
+#include "export.h"
+#include "ingest.h"
+#include "traverse.h"
+#include "pool.h"
+#include "stats.h"
+#include "log.h"
+//gcc -std=c99 -Wall -pthread -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o is_connected is_connected.c export.c ingest.c stats.c pool.c traverse.c cgraph.c log.c graph4.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c
+
+/*
+ * Usage: is_connected map.txt [--serve] [--socket path] [--threads n]
+ *        [--stats] [--log level] [--order list|bfs|rcm|degree]
+ *        [--export adj|mm|dot]
+ *
+ * Reads a map file, builds the graph once and answers "is there a path
+ * from A to B" queries until told to quit. A query can also give a
+ * number of hops, "SRC DEST HOPS", to ask for a path with at most that
+ * many edges; such queries only search as far as needed from both ends
+ * (see trav_hops_bidir() in traverse.h).
+ *
+ * Without options the user is prompted for one query at a time. With
+ * --serve, queries are read as lines "SRC DEST" from stdin and answered
+ * with lines "SRC DEST yes|no|unknown" (or "SRC DEST HOPS ...") on
+ * stdout. With --socket, the same protocol is served to one client at a
+ * time on a Unix domain socket. A line "quit" ends the session. With
+ * --threads, each batch of queries is answered by n worker threads plus
+ * the main thread; answers still come back in input order. The map file
+ * is then also loaded by n + 1 threads (see ingest.h).
+ *
+ * With --stats (and a build with -DGRAPH_STATS), the search and lookup
+ * counters of every query are printed to stderr, in every mode. The
+ * counters are per thread, so --stats answers the queries one by one on
+ * the main thread. --log sets how much diagnostic output goes to stderr:
+ * none, error, warning (the default), info or debug. --order renumbers
+ * the nodes of the compact graph used for queries so that neighbours sit
+ * close together in memory (see cgraph.h). --export writes the graph to
+ * stdout as an adjacency list, a Matrix Market matrix or a DOT graph
+ * (see export.h) and exits without answering queries.
+ *
+ * Map file format: blank lines and lines starting with '#' are ignored.
+ * The first remaining line holds the number of edges, and each of the
+ * following lines holds one edge "SRC DEST".
+ */
 
 #define BUFSIZE 300
+#define NAMELEN 40
+#define READSIZE 65536
 
 /* Return position of first non-whitespace character or -1 if only
 white-space is found. */
@@ -51,67 +107,477 @@ bool line_is_comment(const char *s) {
 	return (i >= 0 && s[i] == '#');
 }
 
+/* Name -> node table used while loading and answering queries. Open
+addressing with linear probing, capacity is a power of two. */
+struct nametab {
+	node **slots;
+	int cap;
+};
 
-int main(int argc, const char **argv) {
-	//char line[BUFSIZE]; // Input buffer
-	//char longest[BUFSIZE] = ""; // Longest string seen so far
-	//int max_len = 0; // Length of longest string seen so far
-	const char *file_name;
-	//const char *dest1 = "UMU";
-	//const char *dest2 = "ABC";
-	FILE *in;
-
-	// Verify number of parameters
-	if (argc <= 1) {
-		fprintf(stderr, "Usage: longest file.txt\n");
-		return -1;
+/* Return a hash value for the string s (FNV-1a). */
+unsigned name_hash(const char *s) {
+	unsigned h = 2166136261u;
+	while (*s) {
+		h = (h ^ (unsigned char)*s++) * 16777619u;
 	}
+	return h;
+}
 
-	// Try to open the input file
-	file_name = argv[1];
-	in = fopen(file_name, "r");
-	if (in == NULL) {
-		fprintf(stderr, "Couldn't open input file %s: %s\n",
-		file_name, strerror(errno));
-		return -1;
+/* Return the node called s, or NULL if there is none. */
+node *nametab_lookup(const struct nametab *t, const char *s) {
+	unsigned i = name_hash(s) & (t->cap - 1);
+	while (t->slots[i] != NULL) {
+		STATS_ADD(lookup_probes, 1);
+		if (!strcmp(graph_node_name(t->slots[i]), s)) {
+			return t->slots[i];
+		}
+		i = (i + 1) & (t->cap - 1);
 	}
-	char ch;
-	while((ch=fgetc(in))!=EOF){
-		if(ch=='\n'){
+	return NULL;
+}
 
+/* Return the node called s, inserting it into the graph if needed.
+Returns NULL if the graph is full. */
+node *nametab_insert(struct nametab *t, graph **g, const char *s) {
+	unsigned i = name_hash(s) & (t->cap - 1);
+	while (t->slots[i] != NULL) {
+		if (!strcmp(graph_node_name(t->slots[i]), s)) {
+			return t->slots[i];
 		}
-		fprintf(stderr, "%c", ch);
+		i = (i + 1) & (t->cap - 1);
 	}
-	/*
-	int i = 1;
-	// Read a line at a time from the input file until EOF
+	int before = graph_nodecount(*g);
+	*g = graph_insert_node(*g, s);
+	if (graph_nodecount(*g) == before) {
+		return NULL;
+	}
+	// graph_insert_node puts new nodes first in the node list.
+	t->slots[i] = graph_choose_node(*g);
+	return t->slots[i];
+}
+
+/* Read a map file into a new graph. Returns NULL on error. */
+graph *load_map(FILE *in, const char *file_name, struct nametab *t) {
+	char line[BUFSIZE];
+	char srcstr[NAMELEN + 1];
+	char deststr[NAMELEN + 1];
+	int edges = -1;
+	int nedges = 0;
+	int lineno = 0;
+	graph *g = NULL;
+
 	while (fgets(line, BUFSIZE, in) != NULL) {
+		lineno++;
 		if (line_is_blank(line) || line_is_comment(line)) {
-		// Ignore blank lines and comment lines.
+			// Ignore blank lines and comment lines.
+			continue;
+		}
+		if (edges < 0) {
+			if (sscanf(line, "%d", &edges) != 1 || edges < 0) {
+				fprintf(stderr, "%s:%d: expected number of edges\n",
+				file_name, lineno);
+				return NULL;
+			}
+			// Every edge brings at most two new nodes.
+			g = graph_empty(2 * edges + 1);
+			t->cap = 16;
+			while (t->cap < 4 * edges + 2) {
+				t->cap *= 2;
+			}
+			t->slots = calloc(t->cap, sizeof(node *));
 			continue;
 		}
-		// How long is the line, ignoring leading and trailing
-		// white-space? (We know there is at least one
-		// non-white-space char.)
-		int beg = first_non_white_space(line);
-		int end = last_non_white_space(line);
-		int len = end - beg + 1;
+		if (sscanf(line, "%40s %40s", srcstr, deststr) != 2) {
+			fprintf(stderr, "%s:%d: expected an edge\n", file_name, lineno);
+			graph_kill(g);
+			free(t->slots);
+			return NULL;
+		}
+		if (++nedges > edges) {
+			fprintf(stderr, "%s:%d: more edges than declared\n", file_name, lineno);
+			graph_kill(g);
+			free(t->slots);
+			return NULL;
+		}
+		node *n1 = nametab_insert(t, &g, srcstr);
+		node *n2 = nametab_insert(t, &g, deststr);
+		if (n1 == NULL || n2 == NULL) {
+			// The graph only has room for the nodes of the declared edges.
+			fprintf(stderr, "%s:%d: too many nodes\n", file_name, lineno);
+			graph_kill(g);
+			free(t->slots);
+			return NULL;
+		}
+		g = graph_insert_edge(g, n1, n2);
+	}
+	if (edges < 0) {
+		fprintf(stderr, "%s: no number of edges found\n", file_name);
+		return NULL;
+	}
+	return g;
+}
 
+/* Fill the name table from a graph loaded by ingest_map(). */
+void nametab_fill(struct nametab *t, const graph *g) {
+	t->cap = 16;
+	while (t->cap < 2 * graph_nodecount(g) + 2) {
+		t->cap *= 2;
+	}
+	t->slots = calloc(t->cap, sizeof(node *));
+	dlist *l = graph_nodes(g);
+	for (dlist_pos p = dlist_first(l); !dlist_is_end(l, p); p = dlist_next(l, p)) {
+		node *n = dlist_inspect(l, p);
+		unsigned i = name_hash(graph_node_name(n)) & (t->cap - 1);
+		while (t->slots[i] != NULL) {
+			i = (i + 1) & (t->cap - 1);
+		}
+		t->slots[i] = n;
+	}
+}
 
+/* State shared by all queries: the name table, the compact graph, the
+search buffers and, with --threads, the worker pool. Queries read from
+one chunk of input are collected in the batch arrays and answered
+together. */
+struct server {
+	const struct nametab *t;
+	const cgraph *c;
+	trav *tr;
+	pool *p;
+	char (*names)[2][NAMELEN + 1];
+	int *kind;
+	int *src;
+	int *dest;
+	int *hops;	// Hop limit, or TRAV_NO_LIMIT.
+	bool *found;
+	int len;
+	int cap;
+	bool stats;
+};
 
-		strncpy(longest, line + beg, len);
+/* Kinds of query lines. */
+#define Q_PATH 0
+#define Q_UNKNOWN 1
+#define Q_ERROR 2
+#define Q_HOPS 3
+
+/* Add one query line to the batch. Returns false if the line asks to
+quit. */
+bool parse_query(const char *line, struct server *srv) {
+	char srcstr[NAMELEN + 1];
+	char deststr[NAMELEN + 1];
+	int hops = TRAV_NO_LIMIT;
+
+	if (line_is_blank(line) || line_is_comment(line)) {
+		return true;
+	}
+	int i = sscanf(line, "%40s %40s %d", srcstr, deststr, &hops);
+	if (i >= 1 && !strcmp(srcstr, "quit")) {
+		return false;
+	}
+	if (srv->stats) {
+		graph_stats_reset();
+	}
+	if (srv->len == srv->cap) {
+		srv->cap = srv->cap ? 2 * srv->cap : 256;
+		srv->names = realloc(srv->names, srv->cap * sizeof(*srv->names));
+		srv->kind = realloc(srv->kind, srv->cap * sizeof(int));
+		srv->src = realloc(srv->src, srv->cap * sizeof(int));
+		srv->dest = realloc(srv->dest, srv->cap * sizeof(int));
+		srv->hops = realloc(srv->hops, srv->cap * sizeof(int));
+		srv->found = realloc(srv->found, srv->cap * sizeof(bool));
+	}
+	int k = srv->len++;
+	srv->kind[k] = Q_ERROR;
+	srv->src[k] = 0;
+	srv->dest[k] = 0;
+	srv->hops[k] = TRAV_NO_LIMIT;
+	if (i < 2 || (i == 3 && hops < 0)) {
+		return true;
+	}
+	strcpy(srv->names[k][0], srcstr);
+	strcpy(srv->names[k][1], deststr);
+	node *n1 = nametab_lookup(srv->t, srcstr);
+	node *n2 = nametab_lookup(srv->t, deststr);
+	if (n1 == NULL || n2 == NULL) {
+		srv->kind[k] = Q_UNKNOWN;
+		return true;
+	}
+	srv->kind[k] = Q_PATH;
+	srv->src[k] = cgraph_id(srv->c, n1);
+	srv->dest[k] = cgraph_id(srv->c, n2);
+	if (i == 3) {
+		// Answered by answer_batch() itself, the pool gets a self-query.
+		srv->kind[k] = Q_HOPS;
+		srv->hops[k] = hops;
+	}
+	return true;
+}
 
-		if(memcmp(longest, dest1, len)){
-			fprintf(stderr, "Found UMU:%d\n",i);
+/* Answer all queries in the batch and write the answers to out in input
+order. Empties the batch. */
+void answer_batch(struct server *srv, FILE *out) {
+	if (srv->p != NULL && !srv->stats) {
+		// Unknown and malformed queries get a harmless self-query.
+		int *dest = malloc((srv->len + 1) * sizeof(int));
+		for (int k = 0; k < srv->len; k++) {
+			dest[k] = srv->kind[k] == Q_HOPS ? srv->src[k] : srv->dest[k];
 		}
+		pool_run(srv->p, srv->src, dest, srv->found, srv->len);
+		free(dest);
+		for (int k = 0; k < srv->len; k++) {
+			if (srv->kind[k] == Q_HOPS) {
+				srv->found[k] = trav_hops_bidir(srv->tr, srv->c, srv->src[k],
+				srv->dest[k], srv->hops[k]) >= 0;
+			}
+		}
+	} else {
+		for (int k = 0; k < srv->len; k++) {
+			if (srv->kind[k] == Q_PATH || srv->kind[k] == Q_HOPS) {
+				srv->found[k] = srv->kind[k] == Q_PATH
+				? trav_reach(srv->tr, srv->c, srv->src[k], srv->dest[k])
+				: trav_hops_bidir(srv->tr, srv->c, srv->src[k], srv->dest[k],
+				srv->hops[k]) >= 0;
+				if (srv->stats) {
+					char label[2 * NAMELEN + 16];
+					sprintf(label, "stats %s %s", srv->names[k][0], srv->names[k][1]);
+					graph_stats_dump(stderr, label);
+				}
+			}
+		}
+	}
+	for (int k = 0; k < srv->len; k++) {
+		if (srv->kind[k] == Q_ERROR) {
+			fprintf(out, "error expected SRC DEST [HOPS]\n");
+		} else if (srv->kind[k] == Q_HOPS) {
+			fprintf(out, "%s %s %d %s\n", srv->names[k][0], srv->names[k][1],
+			srv->hops[k], srv->found[k] ? "yes" : "no");
+		} else {
+			fprintf(out, "%s %s %s\n", srv->names[k][0], srv->names[k][1],
+			srv->kind[k] == Q_UNKNOWN ? "unknown" : srv->found[k] ? "yes" : "no");
+		}
+	}
+	srv->len = 0;
+}
 
-		if(memcmp(longest, dest2, len)){
-			fprintf(stderr, "Found ABC:%d\n",i);
+/* Serve line-delimited queries read from the file descriptor fd until
+end of input or "quit". All complete lines from one read() are
+answered as one batch before the output is flushed once. Returns false
+if the client asked to quit. */
+bool serve_fd(int fd, FILE *out, struct server *srv) {
+	char *buf = malloc(READSIZE + 1);
+	size_t len = 0;
+	bool running = true;
+
+	while (running) {
+		ssize_t r = read(fd, buf + len, READSIZE - len);
+		if (r < 0 && errno == EINTR) {
+			continue;
+		}
+		if (r <= 0) {
+			// End of input: answer a last unterminated line, if any.
+			if (len > 0) {
+				buf[len] = '\0';
+				running = parse_query(buf, srv);
+			}
+			answer_batch(srv, out);
+			break;
+		}
+		len += r;
+		size_t start = 0;
+		for (size_t i = 0; i < len && running; i++) {
+			if (buf[i] == '\n') {
+				buf[i] = '\0';
+				running = parse_query(buf + start, srv);
+				start = i + 1;
+				if (srv->stats) {
+					// Answer at once so the counters cover one query.
+					answer_batch(srv, out);
+				}
+			}
 		}
+		answer_batch(srv, out);
+		// Keep a partial line for the next read.
+		memmove(buf, buf + start, len - start);
+		len -= start;
+		if (len == READSIZE) {
+			fprintf(out, "error line too long\n");
+			len = 0;
+		}
+		fflush(out);
+	}
+	fflush(out);
+	free(buf);
+	return running;
+}
 
-		i++;
+/* Serve queries on a Unix domain socket, one client at a time. Returns
+0 on success or -1 if the socket could not be set up. */
+int serve_socket(const char *path, struct server *srv) {
+	struct sockaddr_un addr;
+	// A client that goes away must not take the server down with it.
+	signal(SIGPIPE, SIG_IGN);
+	int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (lfd < 0) {
+		fprintf(stderr, "socket: %s\n", strerror(errno));
+		return -1;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	unlink(path);
+	if (bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) < 0
+		|| listen(lfd, 16) < 0) {
+		fprintf(stderr, "Couldn't listen on %s: %s\n", path, strerror(errno));
+		close(lfd);
+		return -1;
+	}
+	for (;;) {
+		int cfd = accept(lfd, NULL, NULL);
+		if (cfd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			fprintf(stderr, "accept: %s\n", strerror(errno));
+			break;
+		}
+		FILE *out = fdopen(dup(cfd), "w");
+		if (out == NULL) {
+			close(cfd);
+			continue;
+		}
+		setvbuf(out, NULL, _IOFBF, READSIZE);
+		serve_fd(cfd, out, srv);
+		fclose(out);
+		close(cfd);
+	}
+	close(lfd);
+	unlink(path);
+	return 0;
+}
+
+/* Prompt for queries until the user enters quit or input ends. With
+stats, the counters of every answered query are printed to stderr. */
+void user_interaction(const struct nametab *t, const cgraph *c, trav *tr,
+	bool stats)
+{
+	char line[BUFSIZE];
+	char srcstr[NAMELEN + 1];
+	char deststr[NAMELEN + 1];
+
+	for (;;) {
+		printf("Enter origin and destination (quit to exit): ");
+		fflush(stdout);
+		if (fgets(line, BUFSIZE, stdin) == NULL) {
+			printf("\n");
+			return;
+		}
+		int hops;
+		int i = sscanf(line, "%40s %40s %d", srcstr, deststr, &hops);
+		if (i >= 1 && !strcmp(srcstr, "quit")) {
+			printf("Normal exit.\n");
+			return;
+		}
+		if (i < 2 || (i == 3 && hops < 0)) {
+			printf("Please enter two airport names.\n");
+			continue;
+		}
+		if (stats) {
+			graph_stats_reset();
+		}
+		node *n1 = nametab_lookup(t, srcstr);
+		node *n2 = nametab_lookup(t, deststr);
+		if (n1 == NULL || n2 == NULL) {
+			printf("Unknown airport %s.\n", n1 == NULL ? srcstr : deststr);
+		} else if (i == 3) {
+			printf("There is %s path from %s to %s with at most %d flights.\n",
+			trav_hops_bidir(tr, c, cgraph_id(c, n1), cgraph_id(c, n2), hops) >= 0
+			? "a" : "no", srcstr, deststr, hops);
+		} else if (trav_reach(tr, c, cgraph_id(c, n1), cgraph_id(c, n2))) {
+			printf("There is a path from %s to %s.\n", srcstr, deststr);
+		} else {
+			printf("There is no path from %s to %s.\n", srcstr, deststr);
+		}
+		if (stats && n1 != NULL && n2 != NULL) {
+			char label[2 * NAMELEN + 16];
+			sprintf(label, "stats %s %s", srcstr, deststr);
+			fflush(stdout);
+			graph_stats_dump(stderr, label);
+		}
+	}
+}
+
+/* Return s as a positive int, or -1 if it is anything else. */
+int parse_count(const char *s) {
+	char *end;
+	errno = 0;
+	long v = strtol(s, &end, 10);
+	if (end == s || *end != '\0' || errno != 0 || v < 1 || v > INT_MAX) {
+		return -1;
+	}
+	return v;
+}
+
+int main(int argc, const char **argv) {
+	const char *file_name = NULL;
+	const char *socket_path = NULL;
+	bool serve = false;
+	int threads = 0;
+	bool stats = false;
+	int order = CGRAPH_ORDER_LIST;
+	int export = -1;
+	struct nametab t;
+	FILE *in;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--serve")) {
+			serve = true;
+		} else if (!strcmp(argv[i], "--socket") && i + 1 < argc) {
+			socket_path = argv[++i];
+		} else if (!strcmp(argv[i], "--log") && i + 1 < argc
+			&& log_level_parse(argv[i + 1]) >= 0) {
+			log_level = log_level_parse(argv[++i]);
+		} else if (!strcmp(argv[i], "--order") && i + 1 < argc
+			&& cgraph_order_parse(argv[i + 1]) >= 0) {
+			order = cgraph_order_parse(argv[++i]);
+		} else if (!strcmp(argv[i], "--export") && i + 1 < argc
+			&& graph_export_parse(argv[i + 1]) >= 0) {
+			export = graph_export_parse(argv[++i]);
+		} else if (!strcmp(argv[i], "--stats")) {
+			stats = true;
+		} else if (!strcmp(argv[i], "--threads") && i + 1 < argc
+			&& parse_count(argv[i + 1]) > 0) {
+			threads = parse_count(argv[++i]);
+		} else if (file_name == NULL) {
+			file_name = argv[i];
+		} else {
+			file_name = NULL;
+			break;
+		}
+	}
+	// Verify number of parameters
+	if (file_name == NULL) {
+		fprintf(stderr, "Usage: is_connected map.txt [--serve] [--socket path] [--threads n] [--stats] [--log level]\n"
+		"       [--order list|bfs|rcm|degree] [--export adj|mm|dot]\n");
+		return -1;
+	}
+
+	// Try to open the input file
+	in = fopen(file_name, "r");
+	if (in == NULL) {
+		fprintf(stderr, "Couldn't open input file %s: %s\n",
+		file_name, strerror(errno));
+		return -1;
+	}
+	graph *g;
+	if (threads > 0) {
+		g = ingest_map(in, file_name, threads + 1);
+		if (g != NULL) {
+			nametab_fill(&t, g);
+		}
+	} else {
+		g = load_map(in, file_name, &t);
 	}
-	*/
 
 	// Close files before exit
 	if (fclose(in)) {
@@ -119,6 +585,54 @@ int main(int argc, const char **argv) {
 		file_name, strerror(errno));
 		return -1;
 	}
+	if (g == NULL) {
+		return -1;
+	}
+	if (export >= 0) {
+		int status = graph_export(g, stdout, export);
+		graph_kill(g);
+		free(t.slots);
+		return status;
+	}
 
-	return 0;
+	// The graph does not change from here on, so queries run on a
+	// compact copy with buffers that are reused between queries.
+	cgraph *c = cgraph_freeze_ordered(g, order);
+	struct server srv = {
+		.t = &t,
+		.c = c,
+		.tr = trav_empty(c->nodecount),
+	};
+	int status = 0;
+
+	srv.stats = stats;
+	if (stats && !graph_stats_enabled()) {
+		fprintf(stderr, "Warning: built without GRAPH_STATS, counters stay zero\n");
+	}
+	if (threads > 0) {
+		srv.p = pool_create(c, threads);
+	}
+	if (socket_path != NULL) {
+		status = serve_socket(socket_path, &srv);
+	} else if (serve) {
+		setvbuf(stdout, NULL, _IOFBF, READSIZE);
+		serve_fd(STDIN_FILENO, stdout, &srv);
+	} else {
+		user_interaction(&t, c, srv.tr, stats);
+	}
+
+	if (srv.p != NULL) {
+		pool_kill(srv.p);
+	}
+	free(srv.names);
+	free(srv.kind);
+	free(srv.src);
+	free(srv.dest);
+	free(srv.hops);
+	free(srv.found);
+	trav_kill(srv.tr);
+	cgraph_kill(c);
+	free(t.slots);
+	graph_kill(g);
+	return status;
 }
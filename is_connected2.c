@@ -4,35 +4,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "graph.h"
-#include "queue.h"
-//gcc -std=c99 -Wall -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o is_connected2 is_connected.c graph3.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/list/list.c
-bool find_path(graph *g, node *src, node *dest) {
-	queue *q = queue_empty(NULL);
-	g = graph_node_set_seen(g, src, true);
-	q = queue_enqueue(q, src);
-	printf("Hej");
-	while (!queue_is_empty(q)) {
-		node *n = queue_front(q);
-		q = queue_dequeue(q);
-		dlist *neighbourSet = graph_neighbours(g, n);
-		dlist_pos pos = dlist_first(neighbourSet);
-		while (!dlist_is_end(neighbourSet, pos)) {
-			node *entry = dlist_inspect(neighbourSet, pos);
-			pos = dlist_next(neighbourSet, pos);
-			if (!graph_node_is_seen(g, entry)) {
-				g = graph_node_set_seen(g, entry, true);
-				q = queue_enqueue(q, entry);
-			}
-		}
-	}
-	if (graph_node_is_seen(g, dest)) {
-		return true;
-	}
-	else {
-		return false;
-	}
-}
-
+#include "path.h"
+//gcc -std=c99 -Wall -I../datastructures-v1.0.8.2/datastructures-v1.0.8.2/include -o is_connected2 is_connected.c path.c log.c graph3.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/dlist/dlist.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/queue/queue.c ../datastructures-v1.0.8.2/datastructures-v1.0.8.2/src/list/list.c
 void user_interaction(const graph *g, char *srcstr, char *deststr)
 {
 	char instr[82];
@@ -0,0 +1,52 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log.h"
+
+/*
+ * Implementation of the leveled diagnostic messages.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+int log_level = LOG_LEVEL_WARN;
+
+static const char *level_names[] = { "none", "error", "warning", "info", "debug" };
+
+/**
+ * log_printf() - Print one diagnostic message.
+ * @level: Level of the message.
+ * @fmt: printf() format string, followed by its arguments.
+ *
+ * Use the LOG_* macros instead of calling this directly; they skip the
+ * call, and the evaluation of the arguments, for disabled levels.
+ *
+ * Returns: Nothing.
+ */
+void log_printf(int level, const char *fmt, ...)
+{
+	va_list ap;
+	fprintf(stderr, "%s: ", level_names[level]);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+}
+
+/**
+ * log_level_parse() - Convert a level name to a level.
+ * @s: "none", "error", "warning", "info" or "debug".
+ *
+ * Returns: The level, or -1 if the name is unknown.
+ */
+int log_level_parse(const char *s)
+{
+	for (int i = LOG_LEVEL_NONE; i <= LOG_LEVEL_DEBUG; i++) {
+		if (!strcmp(s, level_names[i])) {
+			return i;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,45 @@
+#ifndef __LOG_H
+#define __LOG_H
+
+/*
+ * Leveled diagnostic messages, written to stderr.
+ *
+ * A message is printed if its level is at most both LOG_LEVEL, fixed at
+ * compile time, and log_level, which can be changed at run time. The
+ * compile-time test is on a constant, so messages above LOG_LEVEL are
+ * removed by the compiler together with their arguments. Build with
+ * -DLOG_LEVEL=LOG_LEVEL_DEBUG to get the tracing on the lookup and
+ * insert paths back.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARN
+#endif
+
+extern int log_level;
+
+void log_printf(int level, const char *fmt, ...);
+int log_level_parse(const char *s);
+
+#define LOG_AT(level, ...) \
+	do { \
+		if (LOG_LEVEL >= (level) && log_level >= (level)) { \
+			log_printf((level), __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+#endif
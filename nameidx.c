@@ -0,0 +1,445 @@
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "cgraph.h"
+#include "nameidx.h"
+
+/*
+ * Implementation of the perfect hash name index.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+#define MAGIC "OU5NIDX1"
+#define SEEDS 64	// Seeds to try before giving up.
+#define TRIES (1u << 24)	// Displacements to try per bucket and seed.
+
+struct nameidx {
+	int n;
+	int nbuckets;
+	unsigned long long seed;
+	unsigned *disp;	// Displacement index per bucket.
+	int *id;	// Dense id per slot.
+	size_t *off;	// Offset of the name in pool per dense id.
+	char *pool;	// All names, in dense id order.
+	size_t poolsize;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static unsigned long long fnv(const char *s)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	while (*s) {
+		h = (h ^ (unsigned char)*s++) * 1099511628211ULL;
+	}
+	return h;
+}
+
+static unsigned long long mix(unsigned long long x)
+{
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+/*
+ * Split the hash h of a name into its bucket b and the two values f and
+ * g that place it in the table for a displacement (d0, d1) at
+ * (f + d0 * g + d1) mod n.
+ */
+static void split(const nameidx *x, unsigned long long h, int *b,
+	unsigned long long *f, unsigned long long *g)
+{
+	unsigned long long y = mix(h ^ x->seed);
+	unsigned long long z = mix(y);
+	*b = (y >> 32) % x->nbuckets;
+	*f = (y & 0xffffffffULL) % x->n;
+	*g = x->n > 1 ? 1 + z % (x->n - 1) : 0;
+}
+
+static int slot_of(const nameidx *x, unsigned long long f,
+	unsigned long long g, unsigned k)
+{
+	return (f + (unsigned long long)(k / x->n) * g + k % x->n) % x->n;
+}
+
+/*
+ * Try to find displacements for all buckets with the current seed.
+ * order holds the keys grouped by bucket, biggest buckets first, and
+ * start[i] .. start[i + 1] - 1 the keys of the i:th of them.
+ *
+ * Returns: True if every bucket was placed.
+ */
+static bool place(nameidx *x, const int *order, const int *start,
+	const int *bucket, int nb, const unsigned long long *f,
+	const unsigned long long *g, bool *taken, int *pos)
+{
+	int free_slot = 0;
+	memset(taken, 0, x->n * sizeof(bool));
+	for (int i = 0; i < nb; i++) {
+		const int *keys = &order[start[i]];
+		int size = start[i + 1] - start[i];
+		int b = bucket[keys[0]];
+		if (size == 1) {
+			// Any free slot can be reached with d0 = 0.
+			while (taken[free_slot]) {
+				free_slot++;
+			}
+			x->disp[b] = (free_slot + x->n - f[keys[0]] % x->n) % x->n;
+			pos[keys[0]] = free_slot;
+			taken[free_slot] = true;
+			continue;
+		}
+		unsigned k;
+		for (k = 0; k < TRIES; k++) {
+			int j;
+			for (j = 0; j < size; j++) {
+				pos[keys[j]] = slot_of(x, f[keys[j]], g[keys[j]], k);
+				if (taken[pos[keys[j]]]) {
+					break;
+				}
+				taken[pos[keys[j]]] = true;
+			}
+			if (j == size) {
+				break;
+			}
+			while (j-- > 0) {
+				taken[pos[keys[j]]] = false;
+			}
+		}
+		if (k == TRIES) {
+			return false;
+		}
+		x->disp[b] = k;
+	}
+	return true;
+}
+
+/*
+ * Return the number of bytes between the position of in and its end,
+ * or -1 if in cannot seek.
+ */
+static long bytes_left(FILE *in)
+{
+	long here = ftell(in);
+	if (here < 0 || fseek(in, 0, SEEK_END) != 0) {
+		return -1;
+	}
+	long end = ftell(in);
+	if (fseek(in, here, SEEK_SET) != 0 || end < here) {
+		return -1;
+	}
+	return end - here;
+}
+
+static nameidx *alloc(int n, int nbuckets)
+{
+	nameidx *x = malloc(sizeof(nameidx));
+	x->n = n;
+	x->nbuckets = nbuckets;
+	x->seed = 0;
+	x->disp = calloc(nbuckets + 1, sizeof(unsigned));
+	x->id = malloc((n + 1) * sizeof(int));
+	x->off = malloc((n + 1) * sizeof(size_t));
+	x->pool = NULL;
+	x->poolsize = 0;
+	return x;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * nameidx_build() - Build the name index of a compact graph.
+ * @c: Compact graph built from a graph, so that it has node pointers.
+ *
+ * Returns: A pointer to the new index, or NULL if the compact graph has
+ * no node pointers or two of its nodes have the same name.
+ */
+nameidx *nameidx_build(const cgraph *c)
+{
+	int n = c->nodecount;
+	if (c->nodes == NULL) {
+		return NULL;
+	}
+	nameidx *x = alloc(n, (n + NAMEIDX_LAMBDA - 1) / NAMEIDX_LAMBDA + 1);
+	unsigned long long *h = malloc((n + 1) * sizeof(unsigned long long));
+	unsigned long long *f = malloc((n + 1) * sizeof(unsigned long long));
+	unsigned long long *g = malloc((n + 1) * sizeof(unsigned long long));
+	int *bucket = malloc((n + 1) * sizeof(int));
+	int *order = malloc((n + 1) * sizeof(int));
+	int *start = malloc((x->nbuckets + 2) * sizeof(int));
+	int *count = malloc((n + 2) * sizeof(int));
+	int *bsize = malloc(x->nbuckets * sizeof(int));
+	int *pos = malloc((n + 1) * sizeof(int));
+	bool *taken = malloc((n + 1) * sizeof(bool));
+
+	for (int v = 0; v < n; v++) {
+		const char *s = graph_node_name(c->nodes[v]);
+		h[v] = fnv(s);
+		x->off[v] = x->poolsize;
+		x->poolsize += strlen(s) + 1;
+	}
+	x->pool = malloc(x->poolsize + 1);
+	for (int v = 0; v < n; v++) {
+		strcpy(x->pool + x->off[v], graph_node_name(c->nodes[v]));
+	}
+
+	bool ok = n == 0;
+	for (int s = 0; s < SEEDS && !ok; s++) {
+		x->seed = mix(s + 1);
+		memset(bsize, 0, x->nbuckets * sizeof(int));
+		for (int v = 0; v < n; v++) {
+			split(x, h[v], &bucket[v], &f[v], &g[v]);
+			bsize[bucket[v]]++;
+		}
+		// Counting sort of the keys by bucket size, biggest first, then by
+		// bucket, so the keys of a bucket end up next to each other.
+		memset(count, 0, (n + 2) * sizeof(int));
+		for (int b = 0; b < x->nbuckets; b++) {
+			count[n - bsize[b]]++;
+		}
+		for (int i = 1; i <= n + 1; i++) {
+			count[i] += count[i - 1];
+		}
+		int *border = malloc((x->nbuckets + 1) * sizeof(int));
+		for (int b = x->nbuckets - 1; b >= 0; b--) {
+			border[--count[n - bsize[b]]] = b;
+		}
+		int *first = malloc((x->nbuckets + 1) * sizeof(int));
+		int nb = 0;
+		int at = 0;
+		for (int i = 0; i < x->nbuckets && bsize[border[i]] > 0; i++) {
+			first[border[i]] = at;
+			start[nb++] = at;
+			at += bsize[border[i]];
+		}
+		start[nb] = at;
+		for (int v = 0; v < n; v++) {
+			order[first[bucket[v]]++] = v;
+		}
+		free(first);
+		free(border);
+
+		// Equal names always share a bucket and never fit in one table.
+		for (int i = 0; i < nb; i++) {
+			for (int j = start[i]; j < start[i + 1]; j++) {
+				for (int k = j + 1; k < start[i + 1]; k++) {
+					if (h[order[j]] == h[order[k]] && !strcmp(x->pool
+						+ x->off[order[j]], x->pool + x->off[order[k]])) {
+						goto out;
+					}
+				}
+			}
+		}
+		memset(x->disp, 0, x->nbuckets * sizeof(unsigned));
+		ok = place(x, order, start, bucket, nb, f, g, taken, pos);
+	}
+	for (int v = 0; v < n && ok; v++) {
+		x->id[pos[v]] = v;
+	}
+
+out:
+	free(taken);
+	free(pos);
+	free(bsize);
+	free(count);
+	free(start);
+	free(order);
+	free(bucket);
+	free(g);
+	free(f);
+	free(h);
+	if (!ok) {
+		nameidx_kill(x);
+		return NULL;
+	}
+	return x;
+}
+
+/**
+ * nameidx_find() - Look up a node by name.
+ * @x: Name index.
+ * @s: Name to look for.
+ *
+ * Returns: The dense id of the node named s, or -1 if there is none.
+ */
+int nameidx_find(const nameidx *x, const char *s)
+{
+	if (x->n == 0) {
+		return -1;
+	}
+	int b;
+	unsigned long long f;
+	unsigned long long g;
+	split(x, fnv(s), &b, &f, &g);
+	int id = x->id[slot_of(x, f, g, x->disp[b])];
+	return strcmp(x->pool + x->off[id], s) ? -1 : id;
+}
+
+/**
+ * nameidx_name() - Return the name of a node.
+ * @x: Name index.
+ * @id: Dense id of the node.
+ *
+ * Returns: The name, owned by the index.
+ */
+const char *nameidx_name(const nameidx *x, int id)
+{
+	return x->pool + x->off[id];
+}
+
+/**
+ * nameidx_size() - Return the memory used by a name index.
+ * @x: Name index.
+ *
+ * Returns: The size in bytes, including the copy of the names.
+ */
+size_t nameidx_size(const nameidx *x)
+{
+	return sizeof(nameidx) + x->nbuckets * sizeof(unsigned)
+		+ x->n * (sizeof(int) + sizeof(size_t)) + x->poolsize;
+}
+
+/**
+ * nameidx_save() - Write a compact graph and its name index to a file.
+ * @x: Name index built from c.
+ * @c: Compact graph.
+ * @out: File opened for binary writing.
+ *
+ * The file holds the outgoing edges of the compact graph, the hash and
+ * the names, in the byte order of the machine.
+ *
+ * Returns: 0 on success, -1 if writing failed.
+ */
+int nameidx_save(const nameidx *x, const cgraph *c, FILE *out)
+{
+	int head[3] = { c->nodecount, c->edgecount, x->nbuckets };
+	bool ok = fwrite(MAGIC, 1, 8, out) == 8
+		&& fwrite(head, sizeof(int), 3, out) == 3
+		&& fwrite(&x->seed, sizeof(x->seed), 1, out) == 1
+		&& fwrite(&x->poolsize, sizeof(x->poolsize), 1, out) == 1
+		&& fwrite(c->out_off, sizeof(int), c->nodecount + 1, out)
+			== (size_t)c->nodecount + 1
+		&& fwrite(c->out, sizeof(int), c->edgecount, out)
+			== (size_t)c->edgecount
+		&& fwrite(x->disp, sizeof(unsigned), x->nbuckets, out)
+			== (size_t)x->nbuckets
+		&& fwrite(x->id, sizeof(int), x->n, out) == (size_t)x->n
+		&& fwrite(x->pool, 1, x->poolsize, out) == x->poolsize;
+	return ok && fflush(out) == 0 ? 0 : -1;
+}
+
+/**
+ * nameidx_load() - Read a compact graph and its name index from a file.
+ * @in: File written by nameidx_save(), opened for binary reading.
+ * @c: Where to store the compact graph.
+ *
+ * The sizes in the header are checked against the length of the file
+ * before anything is allocated, so in must be seekable.
+ *
+ * Returns: The name index, or NULL (with *c set to NULL) if the file is
+ * not a valid index file.
+ */
+nameidx *nameidx_load(FILE *in, cgraph **c)
+{
+	char magic[8];
+	int head[3];
+	unsigned long long seed;
+	size_t poolsize;
+	*c = NULL;
+	if (fread(magic, 1, 8, in) != 8 || memcmp(magic, MAGIC, 8)
+		|| fread(head, sizeof(int), 3, in) != 3
+		|| fread(&seed, sizeof(seed), 1, in) != 1
+		|| fread(&poolsize, sizeof(poolsize), 1, in) != 1
+		|| head[0] < 0 || head[1] < 0 || head[2] < 1
+		|| head[0] == INT_MAX || head[1] == INT_MAX || head[2] == INT_MAX) {
+		return NULL;
+	}
+	int n = head[0];
+	int m = head[1];
+	// Nothing is allocated for sizes the rest of the file cannot hold,
+	// and every one of the n names takes at least its '\0'.
+	unsigned long long need = (2ULL * n + 1 + m) * sizeof(int)
+		+ (unsigned long long)head[2] * sizeof(unsigned);
+	long left = bytes_left(in);
+	if (left < 0 || need > (unsigned long long)left
+		|| poolsize > (unsigned long long)left - need || poolsize < (size_t)n) {
+		return NULL;
+	}
+	nameidx *x = alloc(n, head[2]);
+	x->seed = seed;
+	x->poolsize = poolsize;
+	x->pool = malloc(poolsize + 1);
+	int *off = malloc((n + 1) * sizeof(int));
+	int *src = malloc((m + 1) * sizeof(int));
+	int *dest = malloc((m + 1) * sizeof(int));
+
+	bool ok = fread(off, sizeof(int), n + 1, in) == (size_t)n + 1
+		&& fread(dest, sizeof(int), m, in) == (size_t)m
+		&& fread(x->disp, sizeof(unsigned), x->nbuckets, in)
+			== (size_t)x->nbuckets
+		&& fread(x->id, sizeof(int), n, in) == (size_t)n
+		&& fread(x->pool, 1, poolsize, in) == poolsize
+		&& off[0] == 0 && off[n] == m;
+	// The offsets must not run backwards or past the edges, or the fill
+	// below would write outside src.
+	for (int v = 0; v < n && ok; v++) {
+		ok = off[v] <= off[v + 1] && off[v + 1] <= m;
+	}
+	for (int v = 0; v < n && ok; v++) {
+		ok = x->id[v] >= 0 && x->id[v] < n;
+		for (int i = off[v]; i < off[v + 1] && ok; i++) {
+			src[i] = v;
+			ok = dest[i] >= 0 && dest[i] < n;
+		}
+	}
+	// The names lie one after another, in dense id order.
+	size_t at = 0;
+	for (int v = 0; v < n && ok; v++) {
+		x->off[v] = at;
+		while (at < poolsize && x->pool[at] != '\0') {
+			at++;
+		}
+		ok = at++ < poolsize;
+	}
+	if (ok) {
+		*c = cgraph_from_edges(n, m, src, dest);
+	}
+	free(dest);
+	free(src);
+	free(off);
+	if (!ok) {
+		nameidx_kill(x);
+		return NULL;
+	}
+	return x;
+}
+
+/**
+ * nameidx_kill() - Destroy a name index.
+ * @x: Index to destroy.
+ *
+ * The compact graph is not affected.
+ *
+ * Returns: Nothing.
+ */
+void nameidx_kill(nameidx *x)
+{
+	free(x->disp);
+	free(x->id);
+	free(x->off);
+	free(x->pool);
+	free(x);
+}
@@ -0,0 +1,44 @@
+#ifndef __NAMEIDX_H
+#define __NAMEIDX_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "cgraph.h"
+
+/*
+ * Name lookup for a compact graph through a minimal perfect hash.
+ *
+ * The hash is built once over the names of all nodes with the CHD
+ * (compress, hash and displace) method: the names are hashed into
+ * buckets of about NAMEIDX_LAMBDA names each, and the buckets, largest
+ * first, are each given a displacement that sends all their names to
+ * free slots of a table with exactly one slot per node. A lookup hashes
+ * the name once, reads the displacement of its bucket and lands on the
+ * only slot the name can be in, then compares the name with the copy
+ * kept there. So a lookup is O(length of the name) in the worst case,
+ * whatever the number of nodes, and a name that is not in the graph is
+ * rejected by that one compare.
+ *
+ * The index keeps its own copy of the names and can be saved to a file
+ * together with the compact graph and loaded back without the graph it
+ * was built from. A loaded compact graph has no node pointers, like one
+ * from cgraph_from_edges().
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define NAMEIDX_LAMBDA 4	// Average number of names per bucket.
+
+typedef struct nameidx nameidx;
+
+nameidx *nameidx_build(const cgraph *c);
+int nameidx_find(const nameidx *x, const char *s);
+const char *nameidx_name(const nameidx *x, int id);
+size_t nameidx_size(const nameidx *x);
+int nameidx_save(const nameidx *x, const cgraph *c, FILE *out);
+nameidx *nameidx_load(FILE *in, cgraph **c);
+void nameidx_kill(nameidx *x);
+
+#endif
@@ -0,0 +1,60 @@
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "graph.h"
+#include "queue.h"
+#include "path.h"
+#include "stats.h"
+#include "log.h"
+
+/*
+ * Implementation of path search using the seen flags of the graph.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+/**
+ * find_path() - Check if there is a path between two nodes.
+ * @g: Graph to search.
+ * @src: Node to start from.
+ * @dest: Node to look for.
+ *
+ * Does a breadth-first search from src. The seen flags of all nodes are
+ * reset before the search, so results left by an earlier search or by a
+ * change to the graph do not leak into this one.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool find_path(graph *g, node *src, node *dest)
+{
+	queue *q = queue_empty(NULL);
+	long qlen = 1;
+	STATS_ADD(allocs, 2);
+	g = graph_reset_seen(g);
+	g = graph_node_set_seen(g, src, true);
+	q = queue_enqueue(q, src);
+	LOG_DEBUG("find_path: search started");
+	while (!queue_is_empty(q)) {
+		node *n = queue_front(q);
+		q = queue_dequeue(q);
+		qlen--;
+		STATS_ADD(nodes_visited, 1);
+		dlist *neighbourSet = graph_neighbours(g, n);
+		dlist_pos pos = dlist_first(neighbourSet);
+		while (!dlist_is_end(neighbourSet, pos)) {
+			node *entry = dlist_inspect(neighbourSet, pos);
+			pos = dlist_next(neighbourSet, pos);
+			STATS_ADD(edges_scanned, 1);
+			if (!graph_node_is_seen(g, entry)) {
+				g = graph_node_set_seen(g, entry, true);
+				q = queue_enqueue(q, entry);
+				qlen++;
+				STATS_ADD(allocs, 1);
+			}
+		}
+		STATS_MAX(queue_hwm, qlen);
+	}
+	queue_kill(q);
+	return graph_node_is_seen(g, dest);
+}
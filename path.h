@@ -0,0 +1,17 @@
+#ifndef __PATH_H
+#define __PATH_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * Path search on top of the graph interface in graph.h.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+bool find_path(graph *g, node *src, node *dest);
+
+#endif
@@ -0,0 +1,264 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "cgraph.h"
+#include "traverse.h"
+#include "pool.h"
+
+/*
+ * Implementation of the query worker pool.
+ *
+ * The task queue is the bounded MPMC ring by Dmitry Vyukov: every slot
+ * carries a sequence number that tells producers and consumers whether
+ * the slot is free for the current lap, so both sides only need one
+ * compare-and-swap on their own index. Atomics use the GCC __atomic
+ * builtins. The mutex and condition variables are only used to put idle
+ * workers to sleep and to wake the caller when a batch is done.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define QUEUE_SLOTS 1024	// Must be a power of two.
+#define TASK_SIZE 64		// Queries per task.
+
+// ===========INTERNAL DATA TYPES============
+
+struct task {
+	int begin;
+	int end;
+};
+
+struct slot {
+	unsigned long seq;
+	struct task task;
+};
+
+struct worker {
+	pool *p;
+	trav *t;
+	pthread_t thread;
+};
+
+struct pool {
+	const cgraph *c;
+	int nthreads;
+	struct worker *workers;
+	trav *caller;		// Buffers for the thread calling pool_run().
+
+	struct slot slots[QUEUE_SLOTS];
+	unsigned long enq;
+	unsigned long deq;
+
+	// Current batch. Written before its tasks are enqueued.
+	const int *src;
+	const int *dest;
+	bool *result;
+	int pending;		// Tasks of the batch not yet finished.
+
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+	unsigned long generation;	// Bumped for every batch.
+	bool shutdown;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static bool queue_push(pool *p, struct task t)
+{
+	unsigned long pos = __atomic_load_n(&p->enq, __ATOMIC_RELAXED);
+	for (;;) {
+		struct slot *s = &p->slots[pos & (QUEUE_SLOTS - 1)];
+		unsigned long seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		long diff = (long)(seq - pos);
+		if (diff == 0) {
+			if (__atomic_compare_exchange_n(&p->enq, &pos, pos + 1, true,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				s->task = t;
+				__atomic_store_n(&s->seq, pos + 1, __ATOMIC_RELEASE);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;	// Full.
+		} else {
+			pos = __atomic_load_n(&p->enq, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+static bool queue_pop(pool *p, struct task *t)
+{
+	unsigned long pos = __atomic_load_n(&p->deq, __ATOMIC_RELAXED);
+	for (;;) {
+		struct slot *s = &p->slots[pos & (QUEUE_SLOTS - 1)];
+		unsigned long seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		long diff = (long)(seq - (pos + 1));
+		if (diff == 0) {
+			if (__atomic_compare_exchange_n(&p->deq, &pos, pos + 1, true,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				*t = s->task;
+				__atomic_store_n(&s->seq, pos + QUEUE_SLOTS, __ATOMIC_RELEASE);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;	// Empty.
+		} else {
+			pos = __atomic_load_n(&p->deq, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/*
+ * Take tasks off the queue and answer them until it is empty.
+ */
+static void drain(pool *p, trav *t)
+{
+	struct task task;
+	while (queue_pop(p, &task)) {
+		for (int i = task.begin; i < task.end; i++) {
+			p->result[i] = trav_reach(t, p->c, p->src[i], p->dest[i]);
+		}
+		if (__atomic_sub_fetch(&p->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+			pthread_mutex_lock(&p->lock);
+			pthread_cond_signal(&p->done);
+			pthread_mutex_unlock(&p->lock);
+		}
+	}
+}
+
+static void *worker_main(void *arg)
+{
+	struct worker *w = arg;
+	pool *p = w->p;
+	unsigned long seen = 0;
+
+	for (;;) {
+		pthread_mutex_lock(&p->lock);
+		while (!p->shutdown && p->generation == seen) {
+			pthread_cond_wait(&p->work, &p->lock);
+		}
+		if (p->shutdown) {
+			pthread_mutex_unlock(&p->lock);
+			return NULL;
+		}
+		seen = p->generation;
+		pthread_mutex_unlock(&p->lock);
+		drain(p, w->t);
+	}
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * pool_create() - Start a worker pool.
+ * @c: Compact graph to answer queries on. Must not change while the
+ *     pool is alive.
+ * @nthreads: Number of worker threads to start, besides the caller.
+ *
+ * Returns: A pointer to the new pool.
+ */
+pool *pool_create(const cgraph *c, int nthreads)
+{
+	pool *p = malloc(sizeof(pool));
+	p->c = c;
+	p->nthreads = nthreads;
+	p->enq = 0;
+	p->deq = 0;
+	for (unsigned long i = 0; i < QUEUE_SLOTS; i++) {
+		p->slots[i].seq = i;
+	}
+	p->pending = 0;
+	p->generation = 0;
+	p->shutdown = false;
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->work, NULL);
+	pthread_cond_init(&p->done, NULL);
+
+	p->caller = trav_empty(c->nodecount);
+	p->workers = malloc((nthreads + 1) * sizeof(struct worker));
+	for (int i = 0; i < nthreads; i++) {
+		p->workers[i].p = p;
+		p->workers[i].t = trav_empty(c->nodecount);
+		pthread_create(&p->workers[i].thread, NULL, worker_main, &p->workers[i]);
+	}
+	return p;
+}
+
+/**
+ * pool_run() - Answer a batch of reachability queries.
+ * @p: Worker pool.
+ * @src: Dense ids of the source nodes.
+ * @dest: Dense ids of the destination nodes.
+ * @result: Array to store the answers in; result[i] answers query i.
+ * @n: Number of queries.
+ *
+ * The calling thread helps answering and returns when the whole batch
+ * is done. Only one thread may call pool_run() at a time.
+ *
+ * Returns: Nothing.
+ */
+void pool_run(pool *p, const int *src, const int *dest, bool *result, int n)
+{
+	int begin = 0;
+
+	p->src = src;
+	p->dest = dest;
+	p->result = result;
+	while (begin < n) {
+		// Queue as many tasks as fit, wake the workers and help out.
+		int queued = 0;
+		__atomic_store_n(&p->pending, 0, __ATOMIC_RELAXED);
+		while (begin < n) {
+			struct task t = { begin, begin + TASK_SIZE < n ? begin + TASK_SIZE : n };
+			__atomic_add_fetch(&p->pending, 1, __ATOMIC_RELAXED);
+			if (!queue_push(p, t)) {
+				__atomic_sub_fetch(&p->pending, 1, __ATOMIC_RELAXED);
+				break;
+			}
+			begin = t.end;
+			queued++;
+		}
+		if (queued == 0) {
+			break;
+		}
+		pthread_mutex_lock(&p->lock);
+		p->generation++;
+		pthread_cond_broadcast(&p->work);
+		pthread_mutex_unlock(&p->lock);
+
+		drain(p, p->caller);
+
+		pthread_mutex_lock(&p->lock);
+		while (__atomic_load_n(&p->pending, __ATOMIC_ACQUIRE) > 0) {
+			pthread_cond_wait(&p->done, &p->lock);
+		}
+		pthread_mutex_unlock(&p->lock);
+	}
+}
+
+/**
+ * pool_kill() - Stop the workers and destroy the pool.
+ * @p: Pool to destroy.
+ *
+ * The compact graph is not affected.
+ *
+ * Returns: Nothing.
+ */
+void pool_kill(pool *p)
+{
+	pthread_mutex_lock(&p->lock);
+	p->shutdown = true;
+	pthread_cond_broadcast(&p->work);
+	pthread_mutex_unlock(&p->lock);
+	for (int i = 0; i < p->nthreads; i++) {
+		pthread_join(p->workers[i].thread, NULL);
+		trav_kill(p->workers[i].t);
+	}
+	trav_kill(p->caller);
+	free(p->workers);
+	pthread_cond_destroy(&p->work);
+	pthread_cond_destroy(&p->done);
+	pthread_mutex_destroy(&p->lock);
+	free(p);
+}
@@ -0,0 +1,27 @@
+#ifndef __POOL_H
+#define __POOL_H
+
+#include <stdbool.h>
+
+#include "cgraph.h"
+
+/*
+ * Worker pool that answers reachability queries on all cores.
+ *
+ * The compact graph is shared by all workers and only read. Every worker
+ * owns its own search buffers (see traverse.h). A batch of queries is
+ * cut into small tasks that are handed out through a bounded lock-free
+ * multi-producer/multi-consumer queue; results are written by query
+ * index, so they come back in input order whichever worker answered.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct pool pool;
+
+pool *pool_create(const cgraph *c, int nthreads);
+void pool_run(pool *p, const int *src, const int *dest, bool *result, int n);
+void pool_kill(pool *p);
+
+#endif
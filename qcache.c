@@ -0,0 +1,410 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "batch.h"
+#include "path.h"
+#include "qcache.h"
+
+/*
+ * Implementation of the reachability answer cache.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+#define WAYS 8	// Pair entries per set of the pair table.
+
+struct pair {
+	int src;	// graph_node_id() of the nodes, or -1 if unused.
+	int dest;
+	long ins;	// Insert and delete counts when the answer was found.
+	long del;
+	bool answer;
+	bool ref;	// CLOCK reference bit.
+};
+
+struct rset {
+	int src;	// Source of the reached set, or -1 if unused.
+	long ins;
+	long del;
+	int words;
+	unsigned long long *bits;	// Reached node ids.
+	bool ref;
+};
+
+struct qcache {
+	struct pair *pairs;
+	unsigned char *hand;	// CLOCK hand of every pair set.
+	int mask;	// Number of pair sets - 1.
+	struct rset *sets;
+	int nsets;
+	int sethand;
+	int *slot;	// Index in sets per node id, or -1.
+	unsigned char *misses;	// Misses per node id since its last set.
+	int size;	// Number of node ids the arrays below cover.
+	unsigned *mark;	// Search marks per node id.
+	unsigned stamp;
+	node **queue;
+	long ins;	// Inserts and deletes seen so far.
+	long del;
+	long version;	// graph_version() after the last seen change.
+	struct qcache_stats stats;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static void ensure_size(qcache *q, const graph *g)
+{
+	int bound = graph_id_bound(g);
+	if (bound <= q->size) {
+		return;
+	}
+	int cap = q->size ? q->size : 16;
+	while (cap < bound) {
+		cap *= 2;
+	}
+	q->slot = realloc(q->slot, cap * sizeof(int));
+	q->misses = realloc(q->misses, cap);
+	q->mark = realloc(q->mark, cap * sizeof(unsigned));
+	q->queue = realloc(q->queue, cap * sizeof(node *));
+	for (int i = q->size; i < cap; i++) {
+		q->slot[i] = -1;
+		q->misses[i] = 0;
+		q->mark[i] = 0;
+	}
+	q->size = cap;
+}
+
+/*
+ * Count a change the cache did not see as both an insert and a delete,
+ * so nothing cached before it is used again.
+ */
+static void sync(qcache *q, const graph *g)
+{
+	long v = graph_version(g);
+	if (v != q->version) {
+		q->ins++;
+		q->del++;
+		q->version = v;
+	}
+	ensure_size(q, g);
+}
+
+static bool valid(const qcache *q, bool answer, long ins, long del)
+{
+	return answer ? del == q->del : ins == q->ins;
+}
+
+static struct pair *pair_set(const qcache *q, int src, int dest)
+{
+	unsigned h = (unsigned)src * 0x9e3779b1u ^ (unsigned)dest * 0x85ebca77u;
+	h ^= h >> 15;
+	return &q->pairs[(h & q->mask) * WAYS];
+}
+
+/*
+ * Return the slot to store the answer for src -> dest in, which is the
+ * old slot of the pair if it has one. Otherwise the CLOCK hand of the
+ * set moves past recently used entries to the first one to evict.
+ */
+static struct pair *pair_victim(qcache *q, struct pair *set, int src, int dest)
+{
+	for (int w = 0; w < WAYS; w++) {
+		if (set[w].src == src && set[w].dest == dest) {
+			return &set[w];
+		}
+	}
+	unsigned char *hand = &q->hand[(set - q->pairs) / WAYS];
+	while (set[*hand].ref) {
+		set[*hand].ref = false;
+		*hand = (*hand + 1) % WAYS;
+	}
+	struct pair *p = &set[*hand];
+	*hand = (*hand + 1) % WAYS;
+	return p;
+}
+
+static struct rset *rset_victim(qcache *q)
+{
+	while (q->sets[q->sethand].ref) {
+		q->sets[q->sethand].ref = false;
+		q->sethand = (q->sethand + 1) % q->nsets;
+	}
+	struct rset *s = &q->sets[q->sethand];
+	q->sethand = (q->sethand + 1) % q->nsets;
+	if (s->src >= 0) {
+		q->slot[s->src] = -1;
+	}
+	return s;
+}
+
+/*
+ * Find everything reachable from src with a breadth-first search and
+ * keep it as the reached set of src.
+ */
+static struct rset *build_set(qcache *q, graph *g, node *src)
+{
+	int id = graph_node_id(src);
+	struct rset *s = q->slot[id] >= 0 ? &q->sets[q->slot[id]] : rset_victim(q);
+	int words = (q->size + 63) / 64;
+	if (s->words < words) {
+		s->bits = realloc(s->bits, words * sizeof(unsigned long long));
+		s->words = words;
+	}
+	memset(s->bits, 0, s->words * sizeof(unsigned long long));
+
+	if (++q->stamp == 0) {
+		memset(q->mark, 0, q->size * sizeof(unsigned));
+		q->stamp = 1;
+	}
+	int head = 0;
+	int tail = 0;
+	q->mark[id] = q->stamp;
+	q->queue[tail++] = src;
+	while (head < tail) {
+		node *n = q->queue[head++];
+		int i = graph_node_id(n);
+		s->bits[i / 64] |= 1ULL << (i % 64);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n, nb) {
+			int j = graph_node_id(nb);
+			if (q->mark[j] != q->stamp) {
+				q->mark[j] = q->stamp;
+				q->queue[tail++] = nb;
+			}
+		}
+	}
+
+	s->src = id;
+	s->ins = q->ins;
+	s->del = q->del;
+	s->ref = true;
+	q->slot[id] = s - q->sets;
+	q->misses[id] = 0;
+	q->stats.sets_built++;
+	return s;
+}
+
+static bool rset_has(const struct rset *s, int id)
+{
+	return id < s->words * 64 && (s->bits[id / 64] >> (id % 64) & 1);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * qcache_empty() - Create an empty cache.
+ * @pairs: Number of (source, destination) answers to keep. Rounded up
+ * to a power of two, at least 8.
+ * @sets: Number of reached sets to keep. If 0, misses are answered with
+ * find_path() and only the pair answers are kept.
+ *
+ * Returns: A pointer to the new cache.
+ */
+qcache *qcache_empty(int pairs, int sets)
+{
+	qcache *q = calloc(1, sizeof(qcache));
+	int nsets = 1;
+	while (nsets * WAYS < pairs) {
+		nsets *= 2;
+	}
+	q->pairs = malloc(nsets * WAYS * sizeof(struct pair));
+	q->hand = calloc(nsets, 1);
+	q->mask = nsets - 1;
+	q->nsets = sets > 0 ? sets : 0;
+	q->sets = calloc(q->nsets + 1, sizeof(struct rset));
+	q->version = -1;
+	qcache_clear(q);
+	return q;
+}
+
+/**
+ * qcache_find_path() - Check if there is a path between two nodes.
+ * @q: Cache for the graph.
+ * @g: Graph to search.
+ * @src: Node to start from.
+ * @dest: Node to look for.
+ *
+ * Looks for a valid answer in the pair table, then in the reached set of
+ * src. On a miss find_path() is called, unless src has missed
+ * QCACHE_SET_MISSES times or had a reached set that went stale; then its
+ * reached set is computed and kept instead. A cache that keeps no
+ * reached sets always calls find_path().
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool qcache_find_path(qcache *q, graph *g, node *src, node *dest)
+{
+	sync(q, g);
+	q->stats.queries++;
+	int s = graph_node_id(src);
+	int d = graph_node_id(dest);
+	struct pair *set = pair_set(q, s, d);
+	for (int w = 0; w < WAYS; w++) {
+		struct pair *p = &set[w];
+		if (p->src == s && p->dest == d) {
+			if (valid(q, p->answer, p->ins, p->del)) {
+				p->ref = true;
+				q->stats.pair_hits++;
+				return p->answer;
+			}
+			q->stats.stale++;
+			break;
+		}
+	}
+
+	bool answer;
+	struct rset *r = q->slot[s] >= 0 ? &q->sets[q->slot[s]] : NULL;
+	if (r != NULL && valid(q, rset_has(r, d), r->ins, r->del)) {
+		r->ref = true;
+		answer = rset_has(r, d);
+		q->stats.set_hits++;
+	} else {
+		if (r != NULL) {
+			q->stats.stale++;
+		}
+		q->stats.misses++;
+		if (q->nsets > 0 && (r != NULL || ++q->misses[s] >= QCACHE_SET_MISSES)) {
+			answer = rset_has(build_set(q, g, src), d);
+		} else {
+			answer = find_path(g, src, dest);
+		}
+	}
+
+	struct pair *p = pair_victim(q, set, s, d);
+	p->src = s;
+	p->dest = d;
+	p->ins = q->ins;
+	p->del = q->del;
+	p->answer = answer;
+	p->ref = false;
+	return answer;
+}
+
+/**
+ * qcache_insert_edge() - Insert an edge and invalidate cached "no" answers.
+ * @q: Cache for the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *qcache_insert_edge(qcache *q, graph *g, node *n1, node *n2)
+{
+	sync(q, g);
+	int before = graph_edgecount(g);
+	g = graph_insert_edge(g, n1, n2);
+	if (graph_edgecount(g) != before) {
+		q->ins++;
+	}
+	q->version = graph_version(g);
+	return g;
+}
+
+/**
+ * qcache_delete_edge() - Remove an edge and invalidate cached "yes" answers.
+ * @q: Cache for the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *qcache_delete_edge(qcache *q, graph *g, node *n1, node *n2)
+{
+	sync(q, g);
+	int before = graph_edgecount(g);
+	g = graph_delete_edge(g, n1, n2);
+	if (graph_edgecount(g) != before) {
+		q->del++;
+	}
+	q->version = graph_version(g);
+	return g;
+}
+
+/**
+ * qcache_delete_node() - Remove a node and invalidate cached "yes" answers.
+ * @q: Cache for the graph.
+ * @g: Graph to manipulate.
+ * @n: Node to remove from the graph.
+ *
+ * Node ids are not reused, so entries for the node are never asked for
+ * again and are left to be evicted.
+ *
+ * Returns: The modified graph.
+ */
+graph *qcache_delete_node(qcache *q, graph *g, node *n)
+{
+	sync(q, g);
+	g = graph_delete_node(g, n);
+	q->del++;
+	q->version = graph_version(g);
+	return g;
+}
+
+/**
+ * qcache_stats_get() - Get the hit and miss counts of a cache.
+ * @q: Cache to inspect.
+ * @s: Where to store the counts.
+ *
+ * Returns: Nothing.
+ */
+void qcache_stats_get(const qcache *q, struct qcache_stats *s)
+{
+	*s = q->stats;
+}
+
+/**
+ * qcache_clear() - Forget all cached answers and reset the counts.
+ * @q: Cache to clear.
+ *
+ * Returns: Nothing.
+ */
+void qcache_clear(qcache *q)
+{
+	for (int i = 0; i <= q->mask; i++) {
+		for (int w = 0; w < WAYS; w++) {
+			q->pairs[i * WAYS + w].src = -1;
+			q->pairs[i * WAYS + w].dest = -1;
+			q->pairs[i * WAYS + w].ref = false;
+		}
+		q->hand[i] = 0;
+	}
+	for (int i = 0; i < q->nsets; i++) {
+		q->sets[i].src = -1;
+		q->sets[i].ref = false;
+	}
+	for (int i = 0; i < q->size; i++) {
+		q->slot[i] = -1;
+		q->misses[i] = 0;
+	}
+	q->sethand = 0;
+	memset(&q->stats, 0, sizeof(q->stats));
+}
+
+/**
+ * qcache_kill() - Destroy a cache.
+ * @q: Cache to destroy.
+ *
+ * The graph is not affected.
+ *
+ * Returns: Nothing.
+ */
+void qcache_kill(qcache *q)
+{
+	for (int i = 0; i < q->nsets; i++) {
+		free(q->sets[i].bits);
+	}
+	free(q->sets);
+	free(q->slot);
+	free(q->misses);
+	free(q->mark);
+	free(q->queue);
+	free(q->hand);
+	free(q->pairs);
+	free(q);
+}
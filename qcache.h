@@ -0,0 +1,55 @@
+#ifndef __QCACHE_H
+#define __QCACHE_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * A cache of reachability answers in front of find_path().
+ *
+ * Answers are kept per (source, destination) pair in a set-associative
+ * table with CLOCK replacement within every set. A miss is answered
+ * with find_path(), which stops as soon as it finds the destination.
+ * Once a source has missed QCACHE_SET_MISSES times, its whole reached
+ * set is computed instead and kept as a bitset, so later queries from it
+ * to any destination are answered without a search. Sources that are
+ * asked about once or twice thus never pay for a full search. The
+ * bitsets are replaced with CLOCK as well.
+ *
+ * Changes must go through the qcache_* functions below, like with
+ * dynconn.h. An inserted edge can only make more pairs reachable and a
+ * deleted edge or node can only make fewer reachable, so the cache
+ * counts inserts and deletes separately. A cached "yes" stays valid
+ * until the next delete and a cached "no" until the next insert. Edge
+ * operations that do not change the graph invalidate nothing. Any other
+ * change seen through graph_version() invalidates everything, which
+ * makes the cache depend on graph4.c.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define QCACHE_SET_MISSES 2	// Misses from a source before its set is built.
+
+typedef struct qcache qcache;
+
+struct qcache_stats {
+	long queries;
+	long pair_hits;	// Answered from the pair table.
+	long set_hits;	// Answered from a cached reached set.
+	long misses;	// Answered by a search.
+	long stale;	// Entries found but no longer valid.
+	long sets_built;	// Reached sets computed.
+};
+
+qcache *qcache_empty(int pairs, int sets);
+bool qcache_find_path(qcache *q, graph *g, node *src, node *dest);
+graph *qcache_insert_edge(qcache *q, graph *g, node *n1, node *n2);
+graph *qcache_delete_edge(qcache *q, graph *g, node *n1, node *n2);
+graph *qcache_delete_node(qcache *q, graph *g, node *n);
+void qcache_stats_get(const qcache *q, struct qcache_stats *s);
+void qcache_clear(qcache *q);
+void qcache_kill(qcache *q);
+
+#endif
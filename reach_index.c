@@ -0,0 +1,243 @@
+#include <stdlib.h>
+
+#include "cgraph.h"
+#include "reach_index.h"
+
+/*
+ * Implementation of the pruned landmark labeling reachability index.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+struct reach_index {
+	int nodecount;
+	int *out_off;	// Lout(v) is out_lab[out_off[v]] .. out_lab[out_off[v+1]-1]
+	int *out_lab;
+	int *in_off;
+	int *in_lab;
+};
+
+// Growable label list used while the index is built.
+struct label {
+	int *ranks;
+	int len;
+	int cap;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static void label_push(struct label *l, int rank)
+{
+	if (l->len == l->cap) {
+		l->cap = l->cap ? 2 * l->cap : 4;
+		l->ranks = realloc(l->ranks, l->cap * sizeof(int));
+	}
+	l->ranks[l->len++] = rank;
+}
+
+/*
+ * Return true if two rank lists sorted in increasing order share an
+ * element.
+ */
+static bool ranks_intersect(const int *a, int na, const int *b, int nb)
+{
+	int i = 0;
+	int j = 0;
+	while (i < na && j < nb) {
+		if (a[i] == b[j]) {
+			return true;
+		}
+		if (a[i] < b[j]) {
+			i++;
+		} else {
+			j++;
+		}
+	}
+	return false;
+}
+
+static const cgraph *order_graph;
+
+static long degree_key(int v)
+{
+	const cgraph *c = order_graph;
+	long out = c->out_off[v + 1] - c->out_off[v];
+	long in = c->in_off[v + 1] - c->in_off[v];
+	return (in + 1) * (out + 1);
+}
+
+static int by_degree_desc(const void *a, const void *b)
+{
+	int va = *(const int *)a;
+	int vb = *(const int *)b;
+	long ka = degree_key(va);
+	long kb = degree_key(vb);
+	if (ka != kb) {
+		return ka < kb ? 1 : -1;
+	}
+	return va - vb;
+}
+
+/*
+ * Run one pruned BFS from landmark v with the given rank. With forward
+ * set, the search follows outgoing edges and labels Lin of every node it
+ * keeps; otherwise it follows incoming edges and labels Lout.
+ */
+static void pruned_bfs(const cgraph *c, int v, int rank, bool forward,
+	struct label *lin, struct label *lout, int *mark, int *queue)
+{
+	const int *off = forward ? c->out_off : c->in_off;
+	const int *adj = forward ? c->out : c->in;
+	int head = 0;
+	int tail = 0;
+
+	queue[tail++] = v;
+	mark[v] = rank;
+	while (head < tail) {
+		int u = queue[head++];
+		if (u != v) {
+			// Skip u if an earlier landmark already covers v -> u (or u -> v).
+			bool covered = forward
+				? ranks_intersect(lout[v].ranks, lout[v].len, lin[u].ranks, lin[u].len)
+				: ranks_intersect(lout[u].ranks, lout[u].len, lin[v].ranks, lin[v].len);
+			if (covered) {
+				continue;
+			}
+		}
+		label_push(forward ? &lin[u] : &lout[u], rank);
+		for (int k = off[u]; k < off[u + 1]; k++) {
+			int w = adj[k];
+			if (mark[w] != rank) {
+				mark[w] = rank;
+				queue[tail++] = w;
+			}
+		}
+	}
+}
+
+/*
+ * Pack the growable label lists into one offset array and one flat rank
+ * array and free the lists.
+ */
+static void pack_labels(struct label *l, int n, int **off, int **lab)
+{
+	*off = malloc((n + 1) * sizeof(int));
+	(*off)[0] = 0;
+	for (int v = 0; v < n; v++) {
+		(*off)[v + 1] = (*off)[v] + l[v].len;
+	}
+	*lab = malloc(((*off)[n] + 1) * sizeof(int));
+	for (int v = 0; v < n; v++) {
+		for (int k = 0; k < l[v].len; k++) {
+			(*lab)[(*off)[v] + k] = l[v].ranks[k];
+		}
+		free(l[v].ranks);
+	}
+	free(l);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * reach_index_build() - Build a reachability index for a compact graph.
+ * @c: Compact graph to index.
+ *
+ * Returns: A pointer to the new index.
+ */
+reach_index *reach_index_build(const cgraph *c)
+{
+	int n = c->nodecount;
+	reach_index *ri = malloc(sizeof(reach_index));
+	struct label *lin = calloc(n + 1, sizeof(struct label));
+	struct label *lout = calloc(n + 1, sizeof(struct label));
+	int *order = malloc((n + 1) * sizeof(int));
+	int *fmark = malloc((n + 1) * sizeof(int));
+	int *bmark = malloc((n + 1) * sizeof(int));
+	int *queue = malloc((n + 1) * sizeof(int));
+
+	for (int v = 0; v < n; v++) {
+		order[v] = v;
+		fmark[v] = -1;
+		bmark[v] = -1;
+	}
+	order_graph = c;
+	qsort(order, n, sizeof(int), by_degree_desc);
+
+	// Landmarks are labelled in rank order, so every list stays sorted.
+	// Both searches of a landmark must finish before the next one starts,
+	// otherwise the pruning tests see incomplete labels.
+	for (int r = 0; r < n; r++) {
+		pruned_bfs(c, order[r], r, true, lin, lout, fmark, queue);
+		pruned_bfs(c, order[r], r, false, lin, lout, bmark, queue);
+	}
+	free(order);
+	free(fmark);
+	free(bmark);
+	free(queue);
+
+	ri->nodecount = n;
+	pack_labels(lin, n, &ri->in_off, &ri->in_lab);
+	pack_labels(lout, n, &ri->out_off, &ri->out_lab);
+	return ri;
+}
+
+/**
+ * reach_index_query() - Check if one node can reach another.
+ * @ri: Reachability index.
+ * @src: Dense id of the source node.
+ * @dest: Dense id of the destination node.
+ *
+ * Returns: True if there is a path from src to dest, otherwise false.
+ */
+bool reach_index_query(const reach_index *ri, int src, int dest)
+{
+	if (src == dest) {
+		return true;
+	}
+	return ranks_intersect(ri->out_lab + ri->out_off[src],
+		ri->out_off[src + 1] - ri->out_off[src],
+		ri->in_lab + ri->in_off[dest],
+		ri->in_off[dest + 1] - ri->in_off[dest]);
+}
+
+/**
+ * reach_index_labels() - Return the total number of label entries.
+ * @ri: Reachability index.
+ *
+ * Returns: The summed length of all Lin and Lout lists.
+ */
+long reach_index_labels(const reach_index *ri)
+{
+	return (long)ri->in_off[ri->nodecount] + ri->out_off[ri->nodecount];
+}
+
+/**
+ * reach_index_size() - Return the memory used by the index.
+ * @ri: Reachability index.
+ *
+ * Returns: The size of the index in bytes.
+ */
+size_t reach_index_size(const reach_index *ri)
+{
+	return sizeof(reach_index)
+		+ 2 * (ri->nodecount + 1) * sizeof(int)
+		+ reach_index_labels(ri) * sizeof(int);
+}
+
+/**
+ * reach_index_kill() - Destroy a reachability index.
+ * @ri: Index to destroy.
+ *
+ * Returns: Nothing.
+ */
+void reach_index_kill(reach_index *ri)
+{
+	free(ri->out_off);
+	free(ri->out_lab);
+	free(ri->in_off);
+	free(ri->in_lab);
+	free(ri);
+}
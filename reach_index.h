@@ -0,0 +1,33 @@
+#ifndef __REACH_INDEX_H
+#define __REACH_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cgraph.h"
+
+/*
+ * 2-hop reachability index built with pruned landmark labeling.
+ *
+ * Every node v gets two sorted label lists: Lout(v), the landmarks v can
+ * reach, and Lin(v), the landmarks that can reach v. Node src reaches
+ * node dest exactly when Lout(src) and Lin(dest) share a landmark, so a
+ * query is a merge of two short lists instead of a traversal.
+ *
+ * Landmarks are processed in order of decreasing (indegree+1)*(outdegree+1),
+ * so the hubs that cover most paths are labelled first and later searches
+ * are pruned early.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct reach_index reach_index;
+
+reach_index *reach_index_build(const cgraph *c);
+bool reach_index_query(const reach_index *ri, int src, int dest);
+long reach_index_labels(const reach_index *ri);
+size_t reach_index_size(const reach_index *ri);
+void reach_index_kill(reach_index *ri);
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __SHORTNAME_H
+#define __SHORTNAME_H
+
+#include <stdbool.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+ * Node names packed into 16 bytes for fast compares.
+ *
+ * Most node names are 3 or 4 letter airport codes. shortname_pack()
+ * copies a name of at most SHORTNAME_LEN bytes into two 64-bit words,
+ * padded with zero bytes, so two such names are equal exactly when their
+ * packed forms are, which is two integer compares instead of a byte
+ * loop. A longer name is packed as its first 8 bytes and a 64-bit hash
+ * of the rest, with the last byte never zero, so it can never match the
+ * packed form of a short name. For long names equal packed forms are
+ * necessary but not enough, and the names must also be compared with
+ * strcmp().
+ *
+ * shortname_scan() looks for a packed name in an array of them, with
+ * SSE2 one 16-byte compare per name and four names per step when the
+ * compiler targets it, otherwise with plain integer compares.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define SHORTNAME_LEN 15	// Longest name that is packed whole.
+
+typedef struct shortname {
+	unsigned long long w[2];
+} shortname;
+
+/**
+ * shortname_pack() - Pack a name into 16 bytes.
+ * @s: Name to pack.
+ * @k: Where to store the packed name.
+ *
+ * Returns: True if the whole name fits, i.e. it is at most SHORTNAME_LEN
+ * bytes long.
+ */
+static inline bool shortname_pack(const char *s, shortname *k)
+{
+	unsigned char b[16] = { 0 };
+	int i = 0;
+	while (i < 16 && s[i] != '\0') {
+		b[i] = s[i];
+		i++;
+	}
+	if (i > SHORTNAME_LEN) {
+		// FNV-1a over everything after the first 8 bytes.
+		unsigned long long h = 14695981039346656037ULL;
+		for (const char *p = s + 8; *p != '\0'; p++) {
+			h = (h ^ (unsigned char)*p) * 1099511628211ULL;
+		}
+		for (int j = 8; j < 16; j++) {
+			b[j] = h >> (8 * (j - 8));
+		}
+		b[15] |= 1;
+	}
+	memcpy(k->w, b, 16);
+	return i <= SHORTNAME_LEN;
+}
+
+/**
+ * shortname_equal() - Compare two packed names.
+ * @a: First packed name.
+ * @b: Second packed name.
+ *
+ * Returns: True if the packed forms are equal.
+ */
+static inline bool shortname_equal(const shortname *a, const shortname *b)
+{
+	return ((a->w[0] ^ b->w[0]) | (a->w[1] ^ b->w[1])) == 0;
+}
+
+/**
+ * shortname_scan() - Find a packed name in an array of packed names.
+ * @keys: Array to search.
+ * @from: Index to start at.
+ * @n: Number of names in the array.
+ * @key: Packed name to look for.
+ *
+ * Returns: The first index i >= from with keys[i] equal to key, or -1.
+ */
+static inline int shortname_scan(const shortname *keys, int from, int n,
+	const shortname *key)
+{
+	int i = from;
+#ifdef __SSE2__
+	const __m128i k = _mm_loadu_si128((const __m128i *)key);
+	for (; i + 4 <= n; i += 4) {
+		__m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&keys[i]), k);
+		__m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&keys[i + 1]), k);
+		__m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&keys[i + 2]), k);
+		__m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&keys[i + 3]), k);
+		// A name matches when all 16 of its bytes do.
+		int m0 = _mm_movemask_epi8(e0) == 0xffff;
+		int m1 = _mm_movemask_epi8(e1) == 0xffff;
+		int m2 = _mm_movemask_epi8(e2) == 0xffff;
+		int m3 = _mm_movemask_epi8(e3) == 0xffff;
+		if (m0 | m1 | m2 | m3) {
+			return m0 ? i : m1 ? i + 1 : m2 ? i + 2 : i + 3;
+		}
+	}
+#endif
+	for (; i < n; i++) {
+		if (shortname_equal(&keys[i], key)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+#endif
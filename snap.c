@@ -0,0 +1,614 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graph.h"
+#include "graph_ext.h"
+#include "snap.h"
+
+/*
+ * Implementation of the versioned graph.
+ *
+ * Every row, chunk and version records the number of the version it
+ * was made for. Inside a transaction, objects carrying the number of
+ * the draft are private to the writer and are changed in place; any
+ * other object is shared with published versions and is copied first.
+ * The copied-over object is put on the pending list and handed to the
+ * reclaimer, tagged with the epoch, when the draft is published.
+ *
+ * Atomics use the GCC __atomic builtins. The reader side is two
+ * sequentially consistent operations, an epoch announce and a pointer
+ * load, and one release store on the way out.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+struct row {
+	long version;
+	int degree;
+	int cap;
+	int dest[];	// Sorted.
+};
+
+struct chunk {
+	long version;
+	struct row *rows[SNAP_CHUNK];	// NULL for nodes without edges.
+};
+
+struct snap_version {
+	long version;
+	int idbound;
+	int nchunks;
+	long edgecount;
+	struct chunk **chunks;
+};
+
+struct retired {
+	void *p;
+	unsigned long epoch;
+	struct retired *next;
+};
+
+/* Announced epoch of a reader, alone on its cache line. */
+struct slot {
+	unsigned long epoch;	// 0 when not reading.
+	bool used;
+	char pad[64 - sizeof(unsigned long) - sizeof(bool)];
+};
+
+struct snap {
+	snap_version *current;
+	unsigned long epoch;
+	struct slot slots[SNAP_READERS];
+
+	pthread_mutex_t lock;	// Writers, and readers claiming slots.
+	snap_version *draft;
+	struct retired *pending;	// Replaced by the draft.
+	struct retired *retired;	// Waiting for readers to move on.
+	long nretired;
+};
+
+struct snap_reader {
+	snap *s;
+	int slot;
+	unsigned *mark;
+	unsigned stamp;
+	int *queue;
+	int cap;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static void retire(snap *s, void *p)
+{
+	struct retired *r = malloc(sizeof(struct retired));
+	r->p = p;
+	r->next = s->pending;
+	s->pending = r;
+}
+
+/*
+ * Free the retired memory no reader can see any more. Called with the
+ * lock held.
+ */
+static void collect(snap *s)
+{
+	unsigned long oldest = (unsigned long)-1;
+	for (int k = 0; k < SNAP_READERS; k++) {
+		unsigned long e = __atomic_load_n(&s->slots[k].epoch, __ATOMIC_SEQ_CST);
+		if (e != 0 && e < oldest) {
+			oldest = e;
+		}
+	}
+	struct retired **link = &s->retired;
+	while (*link != NULL) {
+		struct retired *r = *link;
+		if (r->epoch < oldest) {
+			*link = r->next;
+			free(r->p);
+			free(r);
+			s->nretired--;
+		} else {
+			link = &r->next;
+		}
+	}
+}
+
+static struct row *row_new(long version, int cap)
+{
+	struct row *r = malloc(sizeof(struct row) + cap * sizeof(int));
+	r->version = version;
+	r->degree = 0;
+	r->cap = cap;
+	return r;
+}
+
+/* Return the chunk of id in the draft, copying it if it is shared. */
+static struct chunk *own_chunk(snap *s, int id)
+{
+	snap_version *d = s->draft;
+	struct chunk *c = d->chunks[id / SNAP_CHUNK];
+	if (c == NULL) {
+		c = calloc(1, sizeof(struct chunk));
+		c->version = d->version;
+		d->chunks[id / SNAP_CHUNK] = c;
+	} else if (c->version != d->version) {
+		struct chunk *copy = malloc(sizeof(struct chunk));
+		memcpy(copy, c, sizeof(struct chunk));
+		copy->version = d->version;
+		d->chunks[id / SNAP_CHUNK] = copy;
+		retire(s, c);
+		c = copy;
+	}
+	return c;
+}
+
+/*
+ * Return the row of id in the draft with room for at least need
+ * entries, copying it if it is shared.
+ */
+static struct row *own_row(snap *s, int id, int need)
+{
+	struct chunk *c = own_chunk(s, id);
+	struct row *r = c->rows[id % SNAP_CHUNK];
+	if (r != NULL && r->version == s->draft->version && r->cap >= need) {
+		return r;
+	}
+	int cap = r != NULL && 2 * r->degree > need ? 2 * r->degree : need;
+	struct row *copy = row_new(s->draft->version, cap < 4 ? 4 : cap);
+	if (r != NULL) {
+		copy->degree = r->degree;
+		memcpy(copy->dest, r->dest, r->degree * sizeof(int));
+		if (r->version == s->draft->version) {
+			free(r);
+		} else {
+			retire(s, r);
+		}
+	}
+	c->rows[id % SNAP_CHUNK] = copy;
+	return copy;
+}
+
+static const struct row *get_row(const snap_version *v, int id)
+{
+	const struct chunk *c = v->chunks[id / SNAP_CHUNK];
+	return c != NULL ? c->rows[id % SNAP_CHUNK] : NULL;
+}
+
+/* Position of dest in the row, or of where it would go. */
+static int row_search(const struct row *r, int dest)
+{
+	int lo = 0;
+	int hi = r->degree;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (r->dest[mid] < dest) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static int by_value(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * snap_create() - Make a versioned copy of a graph.
+ * @g: Graph to copy.
+ *
+ * The first version holds the edges of g over its node ids. The snap
+ * does not track later changes to g.
+ *
+ * Returns: A pointer to the new snap.
+ */
+snap *snap_create(const graph *g)
+{
+	snap *s = calloc(1, sizeof(snap));
+	pthread_mutex_init(&s->lock, NULL);
+	s->epoch = 1;
+
+	snap_version *v = malloc(sizeof(snap_version));
+	v->version = 1;
+	v->idbound = graph_id_bound(g);
+	v->nchunks = (v->idbound + SNAP_CHUNK - 1) / SNAP_CHUNK;
+	v->chunks = calloc(v->nchunks + 1, sizeof(struct chunk *));
+	v->edgecount = 0;
+	for (int k = 0; k < v->nchunks; k++) {
+		v->chunks[k] = calloc(1, sizeof(struct chunk));
+		v->chunks[k]->version = 1;
+	}
+	dlist *nodes = graph_nodes(g);
+	for (dlist_pos pos = dlist_first(nodes); !dlist_is_end(nodes, pos);
+		pos = dlist_next(nodes, pos)) {
+		node *n = dlist_inspect(nodes, pos);
+		int count;
+		graph_neighbours_span(g, n, &count);
+		if (count == 0) {
+			continue;
+		}
+		struct row *r = row_new(1, count);
+		GRAPH_FOR_EACH_NEIGHBOUR(g, n, nb) {
+			r->dest[r->degree++] = graph_node_id(nb);
+		}
+		qsort(r->dest, r->degree, sizeof(int), by_value);
+		v->chunks[graph_node_id(n) / SNAP_CHUNK]->rows[graph_node_id(n) % SNAP_CHUNK] = r;
+		v->edgecount += count;
+	}
+	s->current = v;
+	return s;
+}
+
+/**
+ * snap_kill() - Destroy a snap and all its versions.
+ * @s: Snap to destroy.
+ *
+ * NOTE: No reader may be using the snap and no transaction may be open.
+ *
+ * Returns: Nothing.
+ */
+void snap_kill(snap *s)
+{
+	// Everything still retired is unreachable now.
+	for (int k = 0; k < SNAP_READERS; k++) {
+		s->slots[k].epoch = 0;
+	}
+	collect(s);
+	snap_version *v = s->current;
+	for (int k = 0; k < v->nchunks; k++) {
+		if (v->chunks[k] != NULL) {
+			for (int i = 0; i < SNAP_CHUNK; i++) {
+				free(v->chunks[k]->rows[i]);
+			}
+			free(v->chunks[k]);
+		}
+	}
+	free(v->chunks);
+	free(v);
+	pthread_mutex_destroy(&s->lock);
+	free(s);
+}
+
+/**
+ * snap_reader_create() - Register a reader of a snap.
+ * @s: Snap to read.
+ *
+ * Every thread reading the snap needs a reader of its own. The reader
+ * also holds the search buffers of snap_reach().
+ *
+ * Returns: A pointer to the new reader, or NULL if SNAP_READERS readers
+ * are registered already.
+ */
+snap_reader *snap_reader_create(snap *s)
+{
+	int slot = -1;
+	pthread_mutex_lock(&s->lock);
+	for (int k = 0; k < SNAP_READERS && slot < 0; k++) {
+		if (!s->slots[k].used) {
+			s->slots[k].used = true;
+			slot = k;
+		}
+	}
+	pthread_mutex_unlock(&s->lock);
+	if (slot < 0) {
+		return NULL;
+	}
+	snap_reader *r = calloc(1, sizeof(snap_reader));
+	r->s = s;
+	r->slot = slot;
+	return r;
+}
+
+/**
+ * snap_read_begin() - Pin the current version of a snap.
+ * @r: Reader.
+ *
+ * The version stays valid, and unchanged, until snap_read_end(). Lock
+ * free: it never waits for a writer.
+ *
+ * Returns: A pointer to the pinned version.
+ */
+const snap_version *snap_read_begin(snap_reader *r)
+{
+	snap *s = r->s;
+	unsigned long e = __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&s->slots[r->slot].epoch, e, __ATOMIC_SEQ_CST);
+	return __atomic_load_n(&s->current, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * snap_read_end() - Unpin the version pinned by snap_read_begin().
+ * @r: Reader.
+ *
+ * Returns: Nothing.
+ */
+void snap_read_end(snap_reader *r)
+{
+	__atomic_store_n(&r->s->slots[r->slot].epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * snap_reach() - Check whether there is a path between two nodes.
+ * @r: Reader, for its search buffers.
+ * @v: Version pinned by r.
+ * @src: Id of the node to start from.
+ * @dest: Id of the node to look for.
+ *
+ * Returns: true if dest can be reached from src in v, otherwise false.
+ */
+bool snap_reach(snap_reader *r, const snap_version *v, int src, int dest)
+{
+	if (v->idbound > r->cap) {
+		free(r->mark);
+		free(r->queue);
+		r->cap = v->idbound;
+		r->mark = calloc(r->cap, sizeof(unsigned));
+		r->queue = malloc(r->cap * sizeof(int));
+		r->stamp = 0;
+	}
+	if (++r->stamp == 0) {
+		memset(r->mark, 0, r->cap * sizeof(unsigned));
+		r->stamp = 1;
+	}
+	int head = 0;
+	int tail = 0;
+	r->mark[src] = r->stamp;
+	r->queue[tail++] = src;
+	while (head < tail) {
+		int u = r->queue[head++];
+		if (u == dest) {
+			return true;
+		}
+		const struct row *row = get_row(v, u);
+		if (row == NULL) {
+			continue;
+		}
+		for (int k = 0; k < row->degree; k++) {
+			int w = row->dest[k];
+			if (r->mark[w] != r->stamp) {
+				r->mark[w] = r->stamp;
+				r->queue[tail++] = w;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * snap_reader_kill() - Unregister a reader.
+ * @r: Reader to destroy. Must not have a version pinned.
+ *
+ * Returns: Nothing.
+ */
+void snap_reader_kill(snap_reader *r)
+{
+	pthread_mutex_lock(&r->s->lock);
+	r->s->slots[r->slot].used = false;
+	pthread_mutex_unlock(&r->s->lock);
+	free(r->mark);
+	free(r->queue);
+	free(r);
+}
+
+/**
+ * snap_version_number() - Return the number of a version.
+ * @v: Version to inspect.
+ *
+ * Returns: The version number, starting at 1 and increased by every
+ * commit.
+ */
+long snap_version_number(const snap_version *v)
+{
+	return v->version;
+}
+
+/**
+ * snap_id_bound() - Return an upper bound on the node ids in a version.
+ * @v: Version to inspect.
+ *
+ * Returns: A value larger than every node id in v.
+ */
+int snap_id_bound(const snap_version *v)
+{
+	return v->idbound;
+}
+
+/**
+ * snap_edgecount() - Return the number of edges in a version.
+ * @v: Version to inspect.
+ *
+ * Returns: The number of edges.
+ */
+long snap_edgecount(const snap_version *v)
+{
+	return v->edgecount;
+}
+
+/**
+ * snap_neighbours() - Return the neighbours of a node in a version.
+ * @v: Version to inspect.
+ * @id: Node id.
+ * @count: Where to store the number of neighbours.
+ *
+ * Returns: A pointer to the *count neighbour ids, sorted. Valid for as
+ * long as v is pinned.
+ */
+const int *snap_neighbours(const snap_version *v, int id, int *count)
+{
+	const struct row *r = get_row(v, id);
+	*count = r != NULL ? r->degree : 0;
+	return r != NULL ? r->dest : NULL;
+}
+
+/**
+ * snap_begin() - Start a transaction.
+ * @s: Snap to change.
+ *
+ * Waits for the transaction of any other writer to be committed.
+ *
+ * Returns: Nothing.
+ */
+void snap_begin(snap *s)
+{
+	pthread_mutex_lock(&s->lock);
+	snap_version *cur = s->current;
+	snap_version *d = malloc(sizeof(snap_version));
+	d->version = cur->version + 1;
+	d->idbound = cur->idbound;
+	d->nchunks = cur->nchunks;
+	d->edgecount = cur->edgecount;
+	d->chunks = malloc((d->nchunks + 1) * sizeof(struct chunk *));
+	memcpy(d->chunks, cur->chunks, d->nchunks * sizeof(struct chunk *));
+	s->draft = d;
+	retire(s, cur->chunks);
+	retire(s, cur);
+}
+
+/**
+ * snap_add_node() - Add a node in the open transaction.
+ * @s: Snap to change.
+ *
+ * Returns: The id of the new node.
+ */
+int snap_add_node(snap *s)
+{
+	snap_version *d = s->draft;
+	int id = d->idbound++;
+	if (id / SNAP_CHUNK >= d->nchunks) {
+		d->nchunks++;
+		d->chunks = realloc(d->chunks, (d->nchunks + 1) * sizeof(struct chunk *));
+		d->chunks[d->nchunks - 1] = NULL;
+	}
+	return id;
+}
+
+/**
+ * snap_delete_node() - Remove all edges to and from a node in the open
+ * transaction.
+ * @s: Snap to change.
+ * @id: Node id.
+ *
+ * The id stays valid, without edges. This scans every row.
+ *
+ * Returns: Nothing.
+ */
+void snap_delete_node(snap *s, int id)
+{
+	snap_version *d = s->draft;
+	for (int u = 0; u < d->idbound; u++) {
+		if (u == id) {
+			continue;
+		}
+		const struct row *r = get_row(d, u);
+		if (r != NULL) {
+			int k = row_search(r, id);
+			if (k < r->degree && r->dest[k] == id) {
+				snap_delete_edge(s, u, id);
+			}
+		}
+	}
+	struct row *r = (struct row *)get_row(d, id);
+	if (r != NULL) {
+		d->edgecount -= r->degree;
+		own_chunk(s, id)->rows[id % SNAP_CHUNK] = NULL;
+		if (r->version == d->version) {
+			free(r);
+		} else {
+			retire(s, r);
+		}
+	}
+}
+
+/**
+ * snap_insert_edge() - Insert an edge in the open transaction.
+ * @s: Snap to change.
+ * @src: Source node id.
+ * @dest: Destination node id.
+ *
+ * Returns: true if the edge was inserted, false if it was there already.
+ */
+bool snap_insert_edge(snap *s, int src, int dest)
+{
+	const struct row *r = get_row(s->draft, src);
+	int k = r != NULL ? row_search(r, dest) : 0;
+	if (r != NULL && k < r->degree && r->dest[k] == dest) {
+		return false;
+	}
+	struct row *own = own_row(s, src, (r != NULL ? r->degree : 0) + 1);
+	memmove(own->dest + k + 1, own->dest + k, (own->degree - k) * sizeof(int));
+	own->dest[k] = dest;
+	own->degree++;
+	s->draft->edgecount++;
+	return true;
+}
+
+/**
+ * snap_delete_edge() - Delete an edge in the open transaction.
+ * @s: Snap to change.
+ * @src: Source node id.
+ * @dest: Destination node id.
+ *
+ * Returns: true if the edge was deleted, false if there was none.
+ */
+bool snap_delete_edge(snap *s, int src, int dest)
+{
+	const struct row *r = get_row(s->draft, src);
+	int k = r != NULL ? row_search(r, dest) : 0;
+	if (r == NULL || k == r->degree || r->dest[k] != dest) {
+		return false;
+	}
+	struct row *own = own_row(s, src, r->degree);
+	memmove(own->dest + k, own->dest + k + 1, (own->degree - k - 1) * sizeof(int));
+	own->degree--;
+	s->draft->edgecount--;
+	return true;
+}
+
+/**
+ * snap_commit() - Publish the open transaction as the current version.
+ * @s: Snap to change.
+ *
+ * Readers that pin a version from now on see the new one. Memory
+ * replaced by the transaction is retired, and retired memory that no
+ * reader can see any more is freed.
+ *
+ * Returns: The number of the new version.
+ */
+long snap_commit(snap *s)
+{
+	snap_version *d = s->draft;
+	__atomic_store_n(&s->current, d, __ATOMIC_SEQ_CST);
+	unsigned long e = __atomic_fetch_add(&s->epoch, 1, __ATOMIC_SEQ_CST);
+	while (s->pending != NULL) {
+		struct retired *r = s->pending;
+		s->pending = r->next;
+		r->epoch = e;
+		r->next = s->retired;
+		s->retired = r;
+		s->nretired++;
+	}
+	s->draft = NULL;
+	collect(s);
+	pthread_mutex_unlock(&s->lock);
+	return d->version;
+}
+
+/**
+ * snap_retired() - Return how many blocks wait to be freed.
+ * @s: Snap to inspect.
+ *
+ * Returns: The number of retired rows, chunks and versions that some
+ * reader may still see.
+ */
+long snap_retired(const snap *s)
+{
+	return s->nretired;
+}
@@ -0,0 +1,65 @@
+#ifndef __SNAP_H
+#define __SNAP_H
+
+#include <stdbool.h>
+
+#include "graph.h"
+
+/*
+ * Versioned copy of a graph for lock-free readers during updates.
+ *
+ * A snap holds a chain of immutable versions of the edges of a graph,
+ * over the node ids of graph_node_id(). Readers pin the current version
+ * with snap_read_begin() and can then walk it for as long as they like
+ * without locks, while a writer builds the next one.
+ *
+ * Writes happen in transactions: snap_begin(), any number of
+ * snap_insert_edge() / snap_delete_edge() / snap_add_node() /
+ * snap_delete_node(), then snap_commit(), which publishes the new
+ * version with one atomic pointer store. Versions share structure: the
+ * neighbour rows are grouped in chunks of SNAP_CHUNK node ids, and a
+ * transaction copies only the rows it changes, the chunks holding them
+ * and the small chunk directory. One writer at a time; transactions of
+ * concurrent writers are serialised by a mutex.
+ *
+ * Replaced rows, chunks and versions are freed through epoch-based
+ * reclamation: every reader announces the global epoch when it pins a
+ * version, each commit advances the epoch, and memory retired at epoch
+ * e is freed once no reader has announced an epoch at or before e.
+ * A reader that stays pinned only delays reclamation, it never blocks
+ * the writer.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define SNAP_CHUNK 256		// Node ids per chunk.
+#define SNAP_READERS 64		// Most readers at the same time.
+
+typedef struct snap snap;
+typedef struct snap_version snap_version;
+typedef struct snap_reader snap_reader;
+
+snap *snap_create(const graph *g);
+void snap_kill(snap *s);
+
+snap_reader *snap_reader_create(snap *s);
+const snap_version *snap_read_begin(snap_reader *r);
+void snap_read_end(snap_reader *r);
+bool snap_reach(snap_reader *r, const snap_version *v, int src, int dest);
+void snap_reader_kill(snap_reader *r);
+
+long snap_version_number(const snap_version *v);
+int snap_id_bound(const snap_version *v);
+long snap_edgecount(const snap_version *v);
+const int *snap_neighbours(const snap_version *v, int id, int *count);
+
+void snap_begin(snap *s);
+int snap_add_node(snap *s);
+void snap_delete_node(snap *s, int id);
+bool snap_insert_edge(snap *s, int src, int dest);
+bool snap_delete_edge(snap *s, int src, int dest);
+long snap_commit(snap *s);
+long snap_retired(const snap *s);
+
+#endif
@@ -0,0 +1,75 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "stats.h"
+
+/*
+ * Implementation of the hot-path counters.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#ifdef GRAPH_STATS
+__thread struct graph_stats graph_stats_tls;
+#endif
+
+/**
+ * graph_stats_enabled() - Check if the counters are compiled in.
+ *
+ * Returns: True if built with GRAPH_STATS, otherwise false.
+ */
+bool graph_stats_enabled(void)
+{
+#ifdef GRAPH_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * graph_stats_get() - Read the counters of the calling thread.
+ * @s: Where to store the counters.
+ *
+ * Returns: Nothing.
+ */
+void graph_stats_get(struct graph_stats *s)
+{
+#ifdef GRAPH_STATS
+	*s = graph_stats_tls;
+#else
+	memset(s, 0, sizeof(*s));
+#endif
+}
+
+/**
+ * graph_stats_reset() - Zero the counters of the calling thread.
+ *
+ * Returns: Nothing.
+ */
+void graph_stats_reset(void)
+{
+#ifdef GRAPH_STATS
+	memset(&graph_stats_tls, 0, sizeof(graph_stats_tls));
+#endif
+}
+
+/**
+ * graph_stats_dump() - Print the counters of the calling thread.
+ * @out: Stream to print to.
+ * @label: Text to start the line with.
+ *
+ * Prints one line of key=value pairs.
+ *
+ * Returns: Nothing.
+ */
+void graph_stats_dump(FILE *out, const char *label)
+{
+	struct graph_stats s;
+	graph_stats_get(&s);
+	fprintf(out, "%s nodes_visited=%ld edges_scanned=%ld queue_hwm=%ld"
+		" lookup_probes=%ld allocs=%ld\n", label, s.nodes_visited,
+		s.edges_scanned, s.queue_hwm, s.lookup_probes, s.allocs);
+}
@@ -0,0 +1,52 @@
+#ifndef __STATS_H
+#define __STATS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * Hot-path counters for traversals and lookups.
+ *
+ * Build with -DGRAPH_STATS to enable them. The counters are per thread:
+ * reset them before a query, run it and read them back to get the cost
+ * of that query alone. Without GRAPH_STATS the STATS_* macros expand to
+ * nothing, so instrumented code is exactly as fast as before, and
+ * graph_stats_get() reports zeros.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+struct graph_stats {
+	long nodes_visited;	// Nodes taken off a search queue.
+	long edges_scanned;	// Neighbour entries looked at.
+	long queue_hwm;		// Largest search queue length seen.
+	long lookup_probes;	// Names compared while looking up nodes.
+	long allocs;		// Dynamic allocations made.
+};
+
+#ifdef GRAPH_STATS
+
+extern __thread struct graph_stats graph_stats_tls;
+
+#define STATS_ADD(field, k) (graph_stats_tls.field += (k))
+#define STATS_MAX(field, v) \
+	do { \
+		if ((long)(v) > graph_stats_tls.field) { \
+			graph_stats_tls.field = (v); \
+		} \
+	} while (0)
+
+#else
+
+#define STATS_ADD(field, k) ((void)0)
+#define STATS_MAX(field, v) ((void)0)
+
+#endif
+
+bool graph_stats_enabled(void);
+void graph_stats_get(struct graph_stats *s);
+void graph_stats_reset(void);
+void graph_stats_dump(FILE *out, const char *label);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef __TIMER_H
+#define __TIMER_H
+
+#include <time.h>
+
+/*
+ * Monotonic wall clock for the benchmark programs. Files including this
+ * header must define _POSIX_C_SOURCE (199309L or later) before their
+ * first #include.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+/**
+ * timer_now() - Read the monotonic clock.
+ *
+ * Returns: The current time in nanoseconds from an arbitrary start.
+ */
+static inline long long timer_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,569 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgraph.h"
+#include "zgraph.h"
+#include "traverse.h"
+#include "stats.h"
+
+/*
+ * Implementation of the reusable breadth-first search.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+struct trav {
+	int nodecount;
+	unsigned stamp;		// Epoch of the current search.
+	unsigned *mark;		// Node v is visited iff mark[v] == stamp.
+	int *queue;
+	int reached;		// Nodes reached by the last trav_reach_set().
+	int *level;		// Where each of its levels starts in queue.
+	int levels;
+	// Backward search of trav_hops_bidir(), made on first use.
+	unsigned *bmark;
+	// Buffers for trav_reach_batch(), made on first use.
+	struct words *words;
+	int *queue2;
+	int *touched;		// Nodes with bits in seen.
+};
+
+/*
+ * The search bits of one node for trav_reach_batch(), bit i for search
+ * i. They are used together, so they share a cache line.
+ */
+struct words {
+	unsigned long long seen;	// Searches that have reached the node.
+	unsigned long long visit;	// Searches that reached it last level.
+	unsigned long long next;	// Searches that reach it next level.
+	unsigned long long want;	// Searches looking for the node.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * Start a new search. Only when the epoch counter wraps do the marks
+ * have to be cleared.
+ */
+static void trav_begin(trav *t)
+{
+	t->stamp++;
+	if (t->stamp == 0) {
+		memset(t->mark, 0, t->nodecount * sizeof(unsigned));
+		if (t->bmark != NULL) {
+			memset(t->bmark, 0, t->nodecount * sizeof(unsigned));
+		}
+		t->stamp = 1;
+	}
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * trav_empty() - Create search buffers.
+ * @nodecount: Number of nodes in the compact graphs to search.
+ *
+ * Returns: A pointer to the new search buffers.
+ */
+trav *trav_empty(int nodecount)
+{
+	trav *t = malloc(sizeof(trav));
+	t->nodecount = nodecount;
+	t->stamp = 0;
+	t->mark = calloc(nodecount + 1, sizeof(unsigned));
+	t->queue = malloc((nodecount + 1) * sizeof(int));
+	t->reached = 0;
+	t->level = malloc((nodecount + 2) * sizeof(int));
+	t->levels = 0;
+	t->bmark = NULL;
+	t->words = NULL;
+	t->queue2 = NULL;
+	t->touched = NULL;
+	return t;
+}
+
+/**
+ * trav_reach() - Check if there is a path between two nodes.
+ * @t: Search buffers.
+ * @c: Compact graph to search.
+ * @src: Dense id of the node to start from.
+ * @dest: Dense id of the node to look for.
+ *
+ * The search stops as soon as dest is found.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool trav_reach(trav *t, const cgraph *c, int src, int dest)
+{
+	int head = 0;
+	int tail = 0;
+
+	if (src == dest) {
+		return true;
+	}
+	trav_begin(t);
+	t->mark[src] = t->stamp;
+	t->queue[tail++] = src;
+	while (head < tail) {
+		int u = t->queue[head++];
+		STATS_ADD(nodes_visited, 1);
+		STATS_ADD(edges_scanned, c->out_off[u + 1] - c->out_off[u]);
+		for (int k = c->out_off[u]; k < c->out_off[u + 1]; k++) {
+			int w = c->out[k];
+			if (t->mark[w] != t->stamp) {
+				if (w == dest) {
+					return true;
+				}
+				t->mark[w] = t->stamp;
+				t->queue[tail++] = w;
+			}
+		}
+		STATS_MAX(queue_hwm, tail - head);
+	}
+	return false;
+}
+
+/**
+ * trav_reach_z() - Check if there is a path between two nodes.
+ * @t: Search buffers.
+ * @z: Compressed graph to search.
+ * @src: Dense id of the node to start from.
+ * @dest: Dense id of the node to look for.
+ *
+ * Same as trav_reach(), but the neighbour lists are decoded while they
+ * are walked.
+ *
+ * Returns: True if dest can be reached from src, otherwise false.
+ */
+bool trav_reach_z(trav *t, const zgraph *z, int src, int dest)
+{
+	int head = 0;
+	int tail = 0;
+
+	if (src == dest) {
+		return true;
+	}
+	trav_begin(t);
+	t->mark[src] = t->stamp;
+	t->queue[tail++] = src;
+	while (head < tail) {
+		int u = t->queue[head++];
+		zgraph_iter it;
+		int w;
+		STATS_ADD(nodes_visited, 1);
+		zgraph_out(z, u, &it);
+		while (zgraph_next(&it, &w)) {
+			STATS_ADD(edges_scanned, 1);
+			if (t->mark[w] != t->stamp) {
+				if (w == dest) {
+					return true;
+				}
+				t->mark[w] = t->stamp;
+				t->queue[tail++] = w;
+			}
+		}
+		STATS_MAX(queue_hwm, tail - head);
+	}
+	return false;
+}
+
+/**
+ * trav_hops() - Find the number of hops between two nodes, up to a limit.
+ * @t: Search buffers.
+ * @c: Compact graph to search.
+ * @src: Dense id of the node to start from.
+ * @dest: Dense id of the node to look for.
+ * @maxhops: Largest number of hops to look for, or TRAV_NO_LIMIT.
+ *
+ * A breadth-first search level by level that stops as soon as dest is
+ * found or all nodes within maxhops hops have been seen.
+ *
+ * Returns: The number of edges on a shortest path from src to dest, or
+ * -1 if there is no path with at most maxhops edges.
+ */
+int trav_hops(trav *t, const cgraph *c, int src, int dest, int maxhops)
+{
+	int head = 0;
+	int tail = 0;
+
+	if (src == dest) {
+		return 0;
+	}
+	trav_begin(t);
+	t->mark[src] = t->stamp;
+	t->queue[tail++] = src;
+	for (int level = 0; head < tail && level != maxhops; level++) {
+		int end = tail;
+		while (head < end) {
+			int u = t->queue[head++];
+			STATS_ADD(nodes_visited, 1);
+			STATS_ADD(edges_scanned, c->out_off[u + 1] - c->out_off[u]);
+			for (int k = c->out_off[u]; k < c->out_off[u + 1]; k++) {
+				int w = c->out[k];
+				if (t->mark[w] != t->stamp) {
+					if (w == dest) {
+						return level + 1;
+					}
+					t->mark[w] = t->stamp;
+					t->queue[tail++] = w;
+				}
+			}
+		}
+		STATS_MAX(queue_hwm, tail - head);
+	}
+	return -1;
+}
+
+/*
+ * Grow one side of a bidirectional search by a level: the nodes in
+ * queue[*head .. *tail) are expanded along off/adj and marked in mark.
+ * Returns true as soon as a node marked in other is found.
+ */
+static bool grow(const int *off, const int *adj, unsigned *mark,
+	const unsigned *other, unsigned stamp, int *queue, int *head, int *tail)
+{
+	int end = *tail;
+	while (*head < end) {
+		int u = queue[(*head)++];
+		STATS_ADD(nodes_visited, 1);
+		STATS_ADD(edges_scanned, off[u + 1] - off[u]);
+		for (int k = off[u]; k < off[u + 1]; k++) {
+			int w = adj[k];
+			if (mark[w] != stamp) {
+				if (other[w] == stamp) {
+					return true;
+				}
+				mark[w] = stamp;
+				queue[(*tail)++] = w;
+			}
+		}
+	}
+	STATS_MAX(queue_hwm, *tail - *head);
+	return false;
+}
+
+/**
+ * trav_hops_bidir() - Find the number of hops between two nodes, up to a
+ * limit, searching from both ends.
+ * @t: Search buffers.
+ * @c: Compact graph to search.
+ * @src: Dense id of the node to start from.
+ * @dest: Dense id of the node to look for.
+ * @maxhops: Largest number of hops to look for, or TRAV_NO_LIMIT.
+ *
+ * Grows a search forward from src and one backward from dest a level at
+ * a time, always the side with fewer nodes in its frontier, until a node
+ * reached by one side is reached by the other. Each side only goes as
+ * deep as needed, so when both ends have small neighbourhoods this
+ * touches far fewer nodes than trav_hops() does.
+ *
+ * Returns: The number of edges on a shortest path from src to dest, or
+ * -1 if there is no path with at most maxhops edges.
+ */
+int trav_hops_bidir(trav *t, const cgraph *c, int src, int dest, int maxhops)
+{
+	int fhead = 0;
+	int ftail = 0;
+	int bhead = 0;
+	int btail = 0;
+	int depth = 0;
+
+	if (src == dest) {
+		return 0;
+	}
+	if (t->bmark == NULL) {
+		t->bmark = calloc(t->nodecount + 1, sizeof(unsigned));
+	}
+	if (t->queue2 == NULL) {
+		t->queue2 = malloc((t->nodecount + 1) * sizeof(int));
+	}
+	trav_begin(t);
+	t->mark[src] = t->stamp;
+	t->queue[ftail++] = src;
+	t->bmark[dest] = t->stamp;
+	t->queue2[btail++] = dest;
+	// Both sides have covered all paths of up to depth edges between them.
+	while (fhead < ftail && bhead < btail && depth != maxhops) {
+		bool met;
+		if (ftail - fhead <= btail - bhead) {
+			met = grow(c->out_off, c->out, t->mark, t->bmark, t->stamp,
+				t->queue, &fhead, &ftail);
+		} else {
+			met = grow(c->in_off, c->in, t->bmark, t->mark, t->stamp,
+				t->queue2, &bhead, &btail);
+		}
+		depth++;
+		if (met) {
+			return depth;
+		}
+	}
+	return -1;
+}
+
+/**
+ * trav_reach_set() - Find all nodes reachable from a set of nodes.
+ * @t: Search buffers.
+ * @c: Compact graph to search.
+ * @src: Dense ids of the nodes to start from. Duplicates are fine.
+ * @nsrc: Number of nodes to start from.
+ * @hops: Largest number of edges on a path to a reached node, or
+ *        TRAV_NO_LIMIT.
+ *
+ * One breadth-first search with all sources in the first level, so every
+ * node is visited at most once however many sources reach it. The
+ * sources themselves count as reached. The result stays in the buffers
+ * until the next search with t.
+ *
+ * Returns: The number of nodes reached.
+ */
+int trav_reach_set(trav *t, const cgraph *c, const int *src, int nsrc, int hops)
+{
+	int head = 0;
+	int tail = 0;
+
+	trav_begin(t);
+	for (int i = 0; i < nsrc; i++) {
+		if (t->mark[src[i]] != t->stamp) {
+			t->mark[src[i]] = t->stamp;
+			t->queue[tail++] = src[i];
+		}
+	}
+	// The queue holds the levels one after the other, so a level ends
+	// where the queue ended when the level was started.
+	t->levels = 0;
+	t->level[0] = 0;
+	for (int level = 0; head < tail && level != hops; level++) {
+		int end = tail;
+		t->level[++t->levels] = end;
+		while (head < end) {
+			int u = t->queue[head++];
+			STATS_ADD(nodes_visited, 1);
+			STATS_ADD(edges_scanned, c->out_off[u + 1] - c->out_off[u]);
+			for (int k = c->out_off[u]; k < c->out_off[u + 1]; k++) {
+				int w = c->out[k];
+				if (t->mark[w] != t->stamp) {
+					t->mark[w] = t->stamp;
+					t->queue[tail++] = w;
+				}
+			}
+		}
+		STATS_MAX(queue_hwm, tail - head);
+	}
+	if (head < tail) {
+		t->level[++t->levels] = tail;
+	}
+	t->reached = tail;
+	return tail;
+}
+
+/**
+ * trav_reached() - Return the nodes reached by the last trav_reach_set().
+ * @t: Search buffers.
+ * @count: Where to store the number of nodes.
+ *
+ * Returns: A pointer to the dense ids of the reached nodes, sources
+ * first, then by number of hops. The array is owned by t and only valid
+ * until the next search with it.
+ */
+const int *trav_reached(const trav *t, int *count)
+{
+	*count = t->reached;
+	return t->queue;
+}
+
+/**
+ * trav_reached_levels() - Return the levels of the last trav_reach_set().
+ * @t: Search buffers.
+ * @count: Where to store the number of levels.
+ *
+ * Returns: A pointer to *count + 1 offsets into the array of
+ * trav_reached(). The nodes first reached after h hops are the ones from
+ * offset h up to offset h + 1. Owned by t and only valid until the next
+ * search with it.
+ */
+const int *trav_reached_levels(const trav *t, int *count)
+{
+	*count = t->levels;
+	return t->level;
+}
+
+/**
+ * trav_is_reached() - Check if the last trav_reach_set() reached a node.
+ * @t: Search buffers.
+ * @v: Dense id of the node.
+ *
+ * Returns: True if v was reached, otherwise false.
+ */
+bool trav_is_reached(const trav *t, int v)
+{
+	return t->mark[v] == t->stamp;
+}
+
+/**
+ * trav_reached_bits() - Copy out the result of the last trav_reach_set().
+ * @t: Search buffers.
+ * @bits: Bitset of (nodecount + 63) / 64 words to overwrite. Bit v % 64
+ *        of word v / 64 is set if node v was reached.
+ *
+ * Returns: Nothing.
+ */
+void trav_reached_bits(const trav *t, unsigned long long *bits)
+{
+	memset(bits, 0, (t->nodecount + 63) / 64 * sizeof(unsigned long long));
+	for (int i = 0; i < t->reached; i++) {
+		int v = t->queue[i];
+		bits[v / 64] |= 1ULL << (v % 64);
+	}
+}
+
+/*
+ * Run up to 64 searches at once, search i from src[i] for dest[i], and
+ * return a word with bit i set if search i found its node. Every level
+ * first collects in next the searches that reach each node for the
+ * first time, then makes those nodes the new frontier. A search that
+ * has found its node is not carried any further.
+ */
+static unsigned long long reach_64(trav *t, const cgraph *c, const int *src,
+	const int *dest, int n)
+{
+	unsigned long long all = n == 64 ? ~0ULL : (1ULL << n) - 1;
+	unsigned long long found = 0;
+	int *cur = t->queue;
+	int *nxt = t->queue2;
+	int len = 0;
+	int touched = 0;
+
+	for (int i = 0; i < n; i++) {
+		unsigned long long bit = 1ULL << i;
+		if (t->words[src[i]].visit == 0) {
+			cur[len++] = src[i];
+			t->touched[touched++] = src[i];
+		}
+		t->words[src[i]].seen |= bit;
+		t->words[src[i]].visit |= bit;
+		if (dest[i] >= 0) {
+			t->words[dest[i]].want |= bit;
+		}
+	}
+	for (int i = 0; i < len; i++) {
+		found |= t->words[cur[i]].seen & t->words[cur[i]].want;
+	}
+
+	while (len > 0 && found != all) {
+		int nlen = 0;
+		for (int i = 0; i < len; i++) {
+			int u = cur[i];
+			// Searches that have found their node stop here.
+			unsigned long long b = t->words[u].visit & ~found;
+			t->words[u].visit = 0;
+			if (b == 0) {
+				continue;
+			}
+			STATS_ADD(nodes_visited, 1);
+			STATS_ADD(edges_scanned, c->out_off[u + 1] - c->out_off[u]);
+			for (int k = c->out_off[u]; k < c->out_off[u + 1]; k++) {
+				int w = c->out[k];
+				unsigned long long d = b & ~t->words[w].seen;
+				if (d != 0) {
+					if (t->words[w].next == 0) {
+						nxt[nlen++] = w;
+					}
+					t->words[w].next |= d;
+				}
+			}
+		}
+		for (int i = 0; i < nlen; i++) {
+			int w = nxt[i];
+			if (t->words[w].seen == 0) {
+				t->touched[touched++] = w;
+			}
+			t->words[w].seen |= t->words[w].next;
+			t->words[w].visit = t->words[w].next;
+			found |= t->words[w].next & t->words[w].want;
+			t->words[w].next = 0;
+		}
+		STATS_MAX(queue_hwm, nlen);
+		int *tmp = cur;
+		cur = nxt;
+		nxt = tmp;
+		len = nlen;
+	}
+
+	// Leave the words clear for the next call. Only nodes that were
+	// reached can have bits set.
+	for (int i = 0; i < len; i++) {
+		t->words[cur[i]].visit = 0;
+	}
+	for (int i = 0; i < touched; i++) {
+		t->words[t->touched[i]].seen = 0;
+	}
+	for (int i = 0; i < n; i++) {
+		if (dest[i] >= 0) {
+			t->words[dest[i]].want = 0;
+		}
+	}
+	return found;
+}
+
+/**
+ * trav_reach_batch() - Check many pairs of nodes for paths.
+ * @t: Search buffers.
+ * @c: Compact graph to search.
+ * @src: Dense ids of the nodes to start from.
+ * @dest: Dense ids of the nodes to look for. A negative id is never
+ *        found, so that search covers everything reachable.
+ * @n: Number of queries.
+ * @result: Array of n entries; result[i] is set to true if dest[i] can
+ *          be reached from src[i], otherwise false.
+ *
+ * The queries are answered 64 at a time by bit-parallel breadth-first
+ * searches, which stop when all 64 have found their node or nothing is
+ * left to visit. Each edge is read once per level for all searches in
+ * the group that reach its source at that level, instead of once per
+ * search. That pays off on graphs with a small diameter, where the
+ * searches soon overlap, and most when many of them have no path and
+ * cover everything reachable. On graphs with a large diameter, like
+ * grids, the searches rarely meet and answering the queries one by one
+ * with trav_reach() is faster.
+ *
+ * Returns: Nothing.
+ */
+void trav_reach_batch(trav *t, const cgraph *c, const int *src, const int *dest,
+	int n, bool *result)
+{
+	if (t->words == NULL) {
+		t->words = calloc(t->nodecount + 1, sizeof(struct words));
+		t->touched = malloc((t->nodecount + 1) * sizeof(int));
+	}
+	if (t->queue2 == NULL) {
+		t->queue2 = malloc((t->nodecount + 1) * sizeof(int));
+	}
+	for (int i = 0; i < n; i += 64) {
+		int k = n - i < 64 ? n - i : 64;
+		unsigned long long found = reach_64(t, c, src + i, dest + i, k);
+		for (int j = 0; j < k; j++) {
+			result[i + j] = found >> j & 1;
+		}
+	}
+}
+
+/**
+ * trav_kill() - Destroy search buffers.
+ * @t: Search buffers to destroy.
+ *
+ * Returns: Nothing.
+ */
+void trav_kill(trav *t)
+{
+	free(t->mark);
+	free(t->queue);
+	free(t->words);
+	free(t->queue2);
+	free(t->touched);
+	free(t->level);
+	free(t->bmark);
+	free(t);
+}
@@ -0,0 +1,59 @@
+#ifndef __TRAVERSE_H
+#define __TRAVERSE_H
+
+#include <stdbool.h>
+
+#include "cgraph.h"
+#include "zgraph.h"
+
+/*
+ * Breadth-first search over a compact graph with reusable buffers.
+ *
+ * A trav holds the visited marks and the queue for one search at a
+ * time. Visited marks are stamped with a per-search epoch, so starting a
+ * new search costs O(1) instead of clearing a flag on every node, and
+ * the compact graph itself is never written to. The same buffers work
+ * for compressed graphs (see zgraph.h).
+ *
+ * trav_reach_set() searches from many sources at once, optionally only
+ * up to a number of hops, and keeps the set of reached nodes in the
+ * buffers until the next search: as a list of dense ids in the order
+ * they were reached (trav_reached()), by membership test
+ * (trav_is_reached()) or copied out as a bitset (trav_reached_bits()).
+ *
+ * trav_hops() and trav_hops_bidir() find the number of hops from one
+ * node to another if it is at most a given limit, and never look further
+ * than the limit. The bidirectional search grows a forward search from
+ * the source and a backward search over the incoming edges from the
+ * destination, always the one with the smaller frontier, until they meet,
+ * so its cost depends on the neighbourhoods of the two nodes. The levels
+ * of trav_reach_set() are available from trav_reached_levels(), for
+ * listing the nodes within k hops of a node level by level.
+ *
+ * trav_reach_batch() answers many src/dest queries with bit-parallel
+ * searches: up to 64 searches run together, one bit each in a word per
+ * node, so every neighbour list is read once per level for all of them.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+typedef struct trav trav;
+
+#define TRAV_NO_LIMIT -1	// No hop limit for trav_reach_set().
+
+trav *trav_empty(int nodecount);
+bool trav_reach(trav *t, const cgraph *c, int src, int dest);
+bool trav_reach_z(trav *t, const zgraph *z, int src, int dest);
+int trav_reach_set(trav *t, const cgraph *c, const int *src, int nsrc, int hops);
+const int *trav_reached(const trav *t, int *count);
+const int *trav_reached_levels(const trav *t, int *count);
+bool trav_is_reached(const trav *t, int v);
+void trav_reached_bits(const trav *t, unsigned long long *bits);
+int trav_hops(trav *t, const cgraph *c, int src, int dest, int maxhops);
+int trav_hops_bidir(trav *t, const cgraph *c, int src, int dest, int maxhops);
+void trav_reach_batch(trav *t, const cgraph *c, const int *src, const int *dest,
+	int n, bool *result);
+void trav_kill(trav *t);
+
+#endif
@@ -0,0 +1,192 @@
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "cgraph.h"
+#include "zgraph.h"
+
+/*
+ * Implementation of the compressed adjacency.
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+static int varint_len(unsigned long long x)
+{
+	int n = 1;
+	while (x >= 0x80) {
+		x >>= 7;
+		n++;
+	}
+	return n;
+}
+
+static unsigned char *varint_put(unsigned char *p, unsigned long long x)
+{
+	while (x >= 0x80) {
+		*p++ = (unsigned char)(x | 0x80);
+		x >>= 7;
+	}
+	*p++ = (unsigned char)x;
+	return p;
+}
+
+static unsigned long long zigzag(long long x)
+{
+	return ((unsigned long long)x << 1) ^ (unsigned long long)(x >> 63);
+}
+
+/*
+ * Encode the lists given by off/adj into a new byte array and build the
+ * index of where each list starts.
+ */
+static unsigned char *encode(int n, const int *off, const int *adj,
+	zgraph_index *idx)
+{
+	int blocks = (n + ZGRAPH_BLOCK - 1) / ZGRAPH_BLOCK;
+	unsigned long long *start = malloc((n + 1) * sizeof(unsigned long long));
+	unsigned long long bytes = 0;
+	int nwide = 0;
+
+	// First pass: where every list starts.
+	for (int v = 0; v < n; v++) {
+		start[v] = bytes;
+		bytes += varint_len(off[v + 1] - off[v]);
+		for (int k = off[v]; k < off[v + 1]; k++) {
+			if (k == off[v]) {
+				bytes += varint_len(zigzag((long long)adj[k] - v));
+			} else {
+				bytes += varint_len(adj[k] - adj[k - 1]);
+			}
+		}
+	}
+	start[n] = bytes;
+	idx->bytes = bytes;
+
+	// The index. Blocks whose last list starts too far from the first
+	// one get wide offsets.
+	idx->base = malloc((blocks + 1) * sizeof(unsigned long long));
+	idx->rel = malloc((n + 1) * sizeof(unsigned short));
+	for (int b = 0; b < blocks; b++) {
+		int first = b * ZGRAPH_BLOCK;
+		int last = first + ZGRAPH_BLOCK < n ? first + ZGRAPH_BLOCK : n;
+		if (start[last - 1] - start[first] > 0xffff) {
+			nwide += ZGRAPH_BLOCK;
+		}
+	}
+	idx->wide = nwide ? malloc(nwide * sizeof(unsigned long long)) : NULL;
+	nwide = 0;
+	for (int b = 0; b < blocks; b++) {
+		int first = b * ZGRAPH_BLOCK;
+		int last = first + ZGRAPH_BLOCK < n ? first + ZGRAPH_BLOCK : n;
+		if (start[last - 1] - start[first] > 0xffff) {
+			idx->base[b] = ZGRAPH_WIDE | nwide;
+			for (int v = first; v < last; v++) {
+				idx->wide[nwide + v - first] = start[v];
+				idx->rel[v] = 0;
+			}
+			nwide += ZGRAPH_BLOCK;
+		} else {
+			idx->base[b] = start[first];
+			for (int v = first; v < last; v++) {
+				idx->rel[v] = (unsigned short)(start[v] - start[first]);
+			}
+		}
+	}
+	free(start);
+
+	// Second pass: the lists themselves.
+	unsigned char *data = malloc(bytes + 1);
+	unsigned char *p = data;
+	for (int v = 0; v < n; v++) {
+		p = varint_put(p, off[v + 1] - off[v]);
+		for (int k = off[v]; k < off[v + 1]; k++) {
+			if (k == off[v]) {
+				p = varint_put(p, zigzag((long long)adj[k] - v));
+			} else {
+				p = varint_put(p, adj[k] - adj[k - 1]);
+			}
+		}
+	}
+	return data;
+}
+
+/* Bytes used by an index over n nodes. */
+static size_t index_size(const zgraph_index *idx, int n)
+{
+	int blocks = (n + ZGRAPH_BLOCK - 1) / ZGRAPH_BLOCK;
+	size_t bytes = blocks * sizeof(unsigned long long) + n * sizeof(unsigned short);
+	for (int b = 0; b < blocks; b++) {
+		if (idx->base[b] & ZGRAPH_WIDE) {
+			bytes += ZGRAPH_BLOCK * sizeof(unsigned long long);
+		}
+	}
+	return bytes;
+}
+
+static void index_free(zgraph_index *idx)
+{
+	free(idx->base);
+	free(idx->rel);
+	free(idx->wide);
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * zgraph_compress() - Build a compressed copy of a compact graph.
+ * @c: Compact graph. Its neighbour lists must be sorted.
+ * @keep_in: Also store the in-neighbour lists.
+ *
+ * The compact graph can be destroyed afterwards; the copy does not refer
+ * to it.
+ *
+ * Returns: A pointer to the new compressed graph.
+ */
+zgraph *zgraph_compress(const cgraph *c, bool keep_in)
+{
+	zgraph *z = malloc(sizeof(zgraph));
+	z->nodecount = c->nodecount;
+	z->edgecount = c->edgecount;
+	z->out = encode(c->nodecount, c->out_off, c->out, &z->out_idx);
+	z->in = NULL;
+	if (keep_in) {
+		z->in = encode(c->nodecount, c->in_off, c->in, &z->in_idx);
+	}
+	return z;
+}
+
+/**
+ * zgraph_size() - Return the memory used by a compressed graph.
+ * @z: Compressed graph.
+ *
+ * Returns: The size in bytes.
+ */
+size_t zgraph_size(const zgraph *z)
+{
+	size_t bytes = sizeof(zgraph) + index_size(&z->out_idx, z->nodecount)
+		+ z->out_idx.bytes;
+	if (z->in != NULL) {
+		bytes += index_size(&z->in_idx, z->nodecount) + z->in_idx.bytes;
+	}
+	return bytes;
+}
+
+/**
+ * zgraph_kill() - Destroy a compressed graph.
+ * @z: Compressed graph to destroy.
+ *
+ * Returns: Nothing.
+ */
+void zgraph_kill(zgraph *z)
+{
+	index_free(&z->out_idx);
+	free(z->out);
+	if (z->in != NULL) {
+		index_free(&z->in_idx);
+		free(z->in);
+	}
+	free(z);
+}
@@ -0,0 +1,129 @@
+#ifndef __ZGRAPH_H
+#define __ZGRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cgraph.h"
+
+/*
+ * Compressed read-only adjacency for very large graphs.
+ *
+ * Each neighbour list of a compact graph is stored as variable-length
+ * integers (7 bits per byte, high bit set on all but the last byte):
+ * the length of the list, the first neighbour relative to the node
+ * itself (zigzag coded, since it can be smaller), and then the gaps
+ * between consecutive neighbours. The lists of a compact graph are
+ * sorted, so the gaps are small, and after a BFS or RCM renumbering
+ * (see cgraph.h) most of them fit in one byte instead of four.
+ *
+ * The start of each list is found through a two-level index: a 64-bit
+ * base offset per block of 64 nodes and a 16-bit offset within the
+ * block per node, about 2 bytes per node instead of 8. A block whose
+ * lists take more than 64 KiB (a block with a big hub) keeps full
+ * 64-bit offsets for its nodes instead.
+ *
+ * Lists are decoded on the fly while they are walked:
+ *
+ *	zgraph_iter it;
+ *	int w;
+ *	zgraph_out(z, v, &it);
+ *	while (zgraph_next(&it, &w)) {
+ *		...
+ *	}
+ *
+ * Version information:
+ *   2026-10-18: v1.0, first version.
+ */
+
+#define ZGRAPH_BLOCK 64
+#define ZGRAPH_WIDE (1ULL << 63)	// Flag on base: block uses wide offsets.
+
+typedef struct zgraph_index {
+	unsigned long long *base;	// Per block: offset, or index into wide.
+	unsigned short *rel;		// Per node: offset from the block base.
+	unsigned long long *wide;	// Per node of wide blocks: offset.
+	unsigned long long bytes;	// Total size of the lists.
+} zgraph_index;
+
+typedef struct zgraph {
+	int nodecount;
+	long long edgecount;
+	zgraph_index out_idx;
+	unsigned char *out;
+	zgraph_index in_idx;
+	unsigned char *in;	// NULL unless in-lists are kept.
+} zgraph;
+
+typedef struct zgraph_iter {
+	const unsigned char *p;
+	unsigned left;	// Neighbours not yet returned.
+	int cur;	// Next neighbour to return, if left > 0.
+} zgraph_iter;
+
+zgraph *zgraph_compress(const cgraph *c, bool keep_in);
+size_t zgraph_size(const zgraph *z);
+void zgraph_kill(zgraph *z);
+
+/* Read one variable-length integer and advance *p past it. */
+static inline unsigned long long zgraph_varint(const unsigned char **p)
+{
+	const unsigned char *q = *p;
+	unsigned long long x = *q & 0x7f;
+	int shift = 7;
+	while (*q++ & 0x80) {
+		x |= (unsigned long long)(*q & 0x7f) << shift;
+		shift += 7;
+	}
+	*p = q;
+	return x;
+}
+
+/* Return the byte offset of the list of node v. */
+static inline unsigned long long zgraph_offset(const zgraph_index *idx, int v)
+{
+	unsigned long long b = idx->base[v / ZGRAPH_BLOCK];
+	if (b & ZGRAPH_WIDE) {
+		return idx->wide[(b & ~ZGRAPH_WIDE) + v % ZGRAPH_BLOCK];
+	}
+	return b + idx->rel[v];
+}
+
+/* Start walking the list at p, belonging to node v. */
+static inline void zgraph_list(const unsigned char *p, int v, zgraph_iter *it)
+{
+	it->p = p;
+	it->left = zgraph_varint(&it->p);
+	it->cur = v;
+	if (it->left > 0) {
+		unsigned long long z = zgraph_varint(&it->p);
+		it->cur = v + (int)((z >> 1) ^ -(long long)(z & 1));
+	}
+}
+
+/* Start walking the out-neighbours of node v. */
+static inline void zgraph_out(const zgraph *z, int v, zgraph_iter *it)
+{
+	zgraph_list(z->out + zgraph_offset(&z->out_idx, v), v, it);
+}
+
+/* Start walking the in-neighbours of node v. Needs keep_in. */
+static inline void zgraph_in(const zgraph *z, int v, zgraph_iter *it)
+{
+	zgraph_list(z->in + zgraph_offset(&z->in_idx, v), v, it);
+}
+
+/* Store the next neighbour in *w. Returns false at the end of the list. */
+static inline bool zgraph_next(zgraph_iter *it, int *w)
+{
+	if (it->left == 0) {
+		return false;
+	}
+	*w = it->cur;
+	if (--it->left > 0) {
+		it->cur += (int)zgraph_varint(&it->p);
+	}
+	return true;
+}
+
+#endif